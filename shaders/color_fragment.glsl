@@ -0,0 +1,17 @@
+#version 330 core
+
+// ============================================================================
+// Galaxies Away - Solid Color Fragment Shader
+// Shared by prefab meshes and UI rects
+// ============================================================================
+
+in vec4 Color;
+
+out vec4 FragColor;
+
+void main() {
+    FragColor = Color;
+    if (FragColor.a < 0.01) {
+        discard;
+    }
+}
@@ -0,0 +1,51 @@
+#version 330 core
+
+// ============================================================================
+// Galaxies Away - GPU Particle Update Shader
+// Advances one particle per vertex; outputs are captured by transform feedback
+// into the other state buffer (no rasterization)
+// ============================================================================
+
+layout (location = 0) in vec2 aPosition;
+layout (location = 1) in vec2 aVelocity;
+layout (location = 2) in float aAge;
+layout (location = 3) in float aLifetime;
+layout (location = 4) in float aDrag;
+layout (location = 5) in float aStartSize;
+layout (location = 6) in float aEndSize;
+layout (location = 7) in vec4 aStartColor;
+layout (location = 8) in vec4 aEndColor;
+
+out vec2 outPosition;
+out vec2 outVelocity;
+out float outAge;
+out float outLifetime;
+out float outDrag;
+out float outStartSize;
+out float outEndSize;
+out vec4 outStartColor;
+out vec4 outEndColor;
+
+uniform float deltaTime;
+
+void main() {
+    outPosition = aPosition;
+    outVelocity = aVelocity;
+    outAge = aAge;
+    outLifetime = aLifetime;
+    outDrag = aDrag;
+    outStartSize = aStartSize;
+    outEndSize = aEndSize;
+    outStartColor = aStartColor;
+    outEndColor = aEndColor;
+    
+    // Dead particles (and new spawns, stepped with zero time) are copied as-is
+    if (aAge >= aLifetime || deltaTime <= 0.0) {
+        return;
+    }
+    
+    // Same integration as Particle::Update: drag, then move
+    outVelocity = aVelocity * pow(aDrag, deltaTime * 60.0);
+    outPosition = aPosition + outVelocity * deltaTime;
+    outAge = aAge + deltaTime;
+}
@@ -0,0 +1,37 @@
+#version 330 core
+
+// ============================================================================
+// Galaxies Away - GPU Particle Vertex Shader
+// Draws the simulated particle buffer as point sprites; color and size are
+// interpolated over each particle's life
+// ============================================================================
+
+layout (location = 0) in vec2 aPosition;
+layout (location = 2) in float aAge;
+layout (location = 3) in float aLifetime;
+layout (location = 5) in float aStartSize;
+layout (location = 6) in float aEndSize;
+layout (location = 7) in vec4 aStartColor;
+layout (location = 8) in vec4 aEndColor;
+
+out vec4 Color;
+
+layout (std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
+
+void main() {
+    // Free slots are parked outside the clip volume
+    if (aAge >= aLifetime) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        gl_PointSize = 1.0;
+        Color = vec4(0.0);
+        return;
+    }
+    
+    float t = aAge / aLifetime;
+    gl_Position = projection * view * vec4(aPosition, 0.0, 1.0);
+    gl_PointSize = mix(aStartSize, aEndSize, t);
+    Color = mix(aStartColor, aEndColor, t);
+}
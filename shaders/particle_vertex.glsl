@@ -2,19 +2,22 @@
 
 // ============================================================================
 // Galaxies Away - Particle Vertex Shader
-// Transforms particle positions for batch rendering
+// One point sprite per particle; the fragment shader rounds it off
 // ============================================================================
 
 layout (location = 0) in vec2 aPos;
-layout (location = 1) in vec2 aTexCoord;
-layout (location = 2) in vec4 aColor;
+layout (location = 1) in float aSize;      // Diameter in pixels
+layout (location = 2) in vec4 aColor;      // Unpacked from RGBA8
 
 out vec4 Color;
 
-uniform mat4 projection;
-uniform mat4 view;
+layout (std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
 
 void main() {
     gl_Position = projection * view * vec4(aPos, 0.0, 1.0);
+    gl_PointSize = aSize;
     Color = aColor;
 }
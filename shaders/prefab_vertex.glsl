@@ -0,0 +1,38 @@
+#version 330 core
+
+// ============================================================================
+// Galaxies Away - Prefab Vertex Shader
+// Places a static multi-part mesh with per-instance transform and tint
+// ============================================================================
+
+layout (location = 0) in vec4 aPart;           // Local position xy, part pivot zw
+layout (location = 1) in vec4 aColor;          // RGBA8
+layout (location = 2) in float aSpin;          // Spin rate of the part
+layout (location = 3) in float aTinted;        // 0 or 1
+
+layout (location = 4) in vec4 iTransform;      // Position xy, scale zw
+layout (location = 5) in vec2 iRotation;       // Rotation, spin angle
+layout (location = 6) in vec4 iTint;           // RGBA8
+
+out vec4 Color;
+
+layout (std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
+
+vec2 Rotate(vec2 v, float angle) {
+    float c = cos(angle);
+    float s = sin(angle);
+    return vec2(v.x * c - v.y * s, v.x * s + v.y * c);
+}
+
+void main() {
+    // Spinning parts turn about their own center, then the whole mesh is
+    // scaled, rotated and moved into place
+    vec2 local = aPart.zw + Rotate(aPart.xy - aPart.zw, aSpin * iRotation.y);
+    vec2 world = Rotate(local * iTransform.zw, iRotation.x) + iTransform.xy;
+    gl_Position = projection * view * vec4(world, 0.0, 1.0);
+    
+    Color = aColor * mix(vec4(1.0), iTint, aTinted);
+}
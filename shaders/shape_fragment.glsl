@@ -0,0 +1,44 @@
+#version 330 core
+
+// ============================================================================
+// Galaxies Away - Shape Fragment Shader
+// Shades circles and rings from their signed distance: an antialiased edge,
+// an optional soft halo outside it and an optional white-hot core
+// ============================================================================
+
+in vec2 Local;
+flat in vec4 Shape;     // Radius, thickness, halo width, core radius
+in vec4 Color;
+
+out vec4 FragColor;
+
+const float HALO_STRENGTH = 0.4;    // Halo opacity where it meets the edge
+const float CORE_WHITENESS = 0.8;
+
+void main() {
+    float radius = Shape.x;
+    float thickness = Shape.y;
+    float halo = Shape.z;
+    float core = Shape.w;
+    
+    // Signed distance to the filled disc, or to the band of a ring
+    float d = length(Local);
+    float dist = thickness > 0.0 ? abs(d - (radius - thickness * 0.5)) - thickness * 0.5 : d - radius;
+    float aa = max(fwidth(d), 0.0001);
+    
+    float alpha = clamp(0.5 - dist / aa, 0.0, 1.0);
+    if (halo > 0.0) {
+        float fade = clamp(1.0 - dist / halo, 0.0, 1.0);
+        alpha = max(alpha, HALO_STRENGTH * fade * fade);
+    }
+    
+    vec3 color = Color.rgb;
+    if (core > 0.0) {
+        color = mix(color, vec3(1.0), CORE_WHITENESS * clamp(0.5 - (d - core) / aa, 0.0, 1.0));
+    }
+    
+    FragColor = vec4(color, Color.a * alpha);
+    if (FragColor.a < 0.01) {
+        discard;
+    }
+}
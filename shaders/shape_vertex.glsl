@@ -0,0 +1,34 @@
+#version 330 core
+
+// ============================================================================
+// Galaxies Away - Shape Vertex Shader
+// One quad per circle, ring or glow, sized to cover the shape and its halo
+// ============================================================================
+
+layout (location = 0) in vec2 aPos;            // Unit quad corner (-0.5 .. 0.5)
+
+layout (location = 3) in vec4 iShape;          // Center xy, radius, ring thickness (0 = filled)
+layout (location = 4) in vec2 iGlow;           // Halo width, hot core radius (fraction of radius)
+layout (location = 5) in vec4 iColor;          // RGBA8
+layout (location = 6) in float iScreenSpace;   // 0 or 1
+
+out vec2 Local;                                 // Offset from the center, in world units
+flat out vec4 Shape;                            // Radius, thickness, halo width, core radius
+out vec4 Color;
+
+layout (std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
+
+void main() {
+    // One unit of margin keeps the antialiased edge inside the quad
+    float extent = iShape.z + iGlow.x + 1.0;
+    Local = aPos * 2.0 * extent;
+    
+    vec4 position = vec4(iShape.xy + Local, 0.0, 1.0);
+    gl_Position = projection * (iScreenSpace > 0.5 ? position : view * position);
+    
+    Shape = vec4(iShape.zw, iGlow.x, iGlow.y * iShape.z);
+    Color = iColor;
+}
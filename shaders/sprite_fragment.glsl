@@ -0,0 +1,24 @@
+#version 330 core
+
+// ============================================================================
+// Galaxies Away - Instanced Sprite Fragment Shader
+// Untextured instances ignore the sampler so they can share any batch
+// ============================================================================
+
+in vec2 TexCoord;
+in vec4 Color;
+flat in float Textured;
+
+out vec4 FragColor;
+
+uniform sampler2D textureSampler;
+
+void main() {
+    vec4 texColor = Textured > 0.5 ? texture(textureSampler, TexCoord) : vec4(1.0);
+    FragColor = texColor * Color;
+    
+    // Discard fully transparent pixels for better blending
+    if (FragColor.a < 0.01) {
+        discard;
+    }
+}
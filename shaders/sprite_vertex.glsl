@@ -0,0 +1,39 @@
+#version 330 core
+
+// ============================================================================
+// Galaxies Away - Instanced Sprite Vertex Shader
+// Builds each sprite's transform from per-instance data
+// ============================================================================
+
+layout (location = 0) in vec2 aPos;            // Unit quad corner (-0.5 .. 0.5)
+
+layout (location = 3) in vec4 iTransform;      // Center xy, size zw
+layout (location = 4) in vec4 iUVRect;         // u0, v0, u1, v1 (unorm16)
+layout (location = 5) in vec4 iColor;          // RGBA8
+layout (location = 6) in float iRotation;
+layout (location = 7) in vec2 iFlags;          // Textured, screen space (0 or 1)
+
+out vec2 TexCoord;
+out vec4 Color;
+flat out float Textured;
+
+layout (std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
+
+void main() {
+    // Scale, rotate, then translate (same order as the old model matrix)
+    vec2 local = aPos * iTransform.zw;
+    float c = cos(iRotation);
+    float s = sin(iRotation);
+    vec2 world = vec2(local.x * c - local.y * s, local.x * s + local.y * c) + iTransform.xy;
+    
+    // Screen-space sprites (UI) skip the camera
+    vec4 position = vec4(world, 0.0, 1.0);
+    gl_Position = projection * (iFlags.y > 0.5 ? position : view * position);
+    
+    TexCoord = mix(iUVRect.xy, iUVRect.zw, aPos + 0.5);
+    Color = iColor;
+    Textured = iFlags.x;
+}
@@ -0,0 +1,13 @@
+#version 330 core
+
+// ============================================================================
+// Galaxies Away - Starfield Fragment Shader
+// ============================================================================
+
+in float Alpha;
+
+out vec4 FragColor;
+
+void main() {
+    FragColor = vec4(1.0, 1.0, 1.0, Alpha);
+}
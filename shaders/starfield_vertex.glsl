@@ -0,0 +1,31 @@
+#version 330 core
+
+// ============================================================================
+// Galaxies Away - Starfield Vertex Shader
+// Static per-star data; scrolling, wrapping and twinkle are computed here
+// ============================================================================
+
+layout (location = 0) in vec2 aPos;            // Unit quad corner (-0.5 .. 0.5)
+
+layout (location = 3) in vec4 iStar;           // Position xy (within the viewport), size, brightness
+layout (location = 4) in vec3 iTwinkle;        // Twinkle speed, twinkle phase, parallax
+
+out float Alpha;
+
+layout (std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
+
+uniform float time;
+uniform vec2 viewportSize;
+
+void main() {
+    // view[3].xy is the camera translation (including shake); layers scroll by
+    // a fraction of it and wrap around the viewport so the field never runs out
+    vec2 center = mod(iStar.xy + view[3].xy * iTwinkle.z, viewportSize);
+    gl_Position = projection * vec4(center + aPos * iStar.z, 0.0, 1.0);
+    
+    float twinkle = 0.5 + 0.5 * sin(time * iTwinkle.x + iTwinkle.y);
+    Alpha = iStar.w * (0.5 + 0.5 * twinkle);
+}
@@ -2,17 +2,17 @@
 
 // ============================================================================
 // Galaxies Away - Text Fragment Shader
-// Renders FreeType font glyphs with color
+// Renders FreeType font glyphs from the atlas with per-vertex color
 // ============================================================================
 
 in vec2 TexCoords;
+in vec4 TextColor;
 out vec4 FragColor;
 
 uniform sampler2D text;
-uniform vec4 textColor;
 
 void main() {
-    // Sample the red channel (grayscale glyph texture)
+    // Sample the red channel (grayscale glyph atlas)
     vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
-    FragColor = textColor * sampled;
+    FragColor = TextColor * sampled;
 }
@@ -2,16 +2,23 @@
 
 // ============================================================================
 // Galaxies Away - Text Vertex Shader
-// Handles glyph quad positioning for text rendering
+// Handles batched glyph quads for text rendering
 // ============================================================================
 
-layout (location = 0) in vec4 vertex; // vec2 pos, vec2 tex
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;   // Font atlas coordinates (unorm16)
+layout (location = 2) in vec4 aColor;      // RGBA8
 
 out vec2 TexCoords;
+out vec4 TextColor;
 
-uniform mat4 projection;
+layout (std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
 
 void main() {
-    gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
-    TexCoords = vertex.zw;
+    gl_Position = projection * vec4(aPos, 0.0, 1.0);
+    TexCoords = aTexCoord;
+    TextColor = aColor;
 }
@@ -0,0 +1,23 @@
+#version 330 core
+
+// ============================================================================
+// Galaxies Away - UI Rect Vertex Shader
+// Axis-aligned screen-space rects, clipped on the CPU
+// ============================================================================
+
+layout (location = 0) in vec2 aPos;            // Unit quad corner (-0.5 .. 0.5)
+
+layout (location = 3) in vec4 iRect;           // Min xy, max zw, in pixels
+layout (location = 5) in vec4 iColor;          // RGBA8
+
+out vec4 Color;
+
+layout (std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
+
+void main() {
+    gl_Position = projection * vec4(mix(iRect.xy, iRect.zw, aPos + 0.5), 0.0, 1.0);
+    Color = iColor;
+}
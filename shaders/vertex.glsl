@@ -12,8 +12,11 @@ layout (location = 2) in vec4 aColor;
 out vec2 TexCoord;
 out vec4 Color;
 
-uniform mat4 projection;
-uniform mat4 view;
+layout (std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
+
 uniform mat4 model;
 
 void main() {
@@ -16,22 +16,22 @@ void BasicEnemy::UpdateBehavior(float deltaTime, Game* game) {
     Enemy::MoveTowardsPlayer(deltaTime, game);
 }
 
-void BasicEnemy::Render(Renderer* renderer) {
-    // Get the enemy texture from the game
-    Texture* enemyTex = nullptr;
+void BasicEnemy::Render(IRenderer* renderer) {
+    // Get the enemy sprite from the game's atlas
+    int enemySprite = -1;
     if (g_Game) {
-        enemyTex = g_Game->GetEnemyTexture();
+        enemySprite = g_Game->GetEnemySprite();
     }
     
     // Determine facing direction based on velocity
     // Flip horizontally when facing left (negative x velocity)
     bool facingLeft = velocity.x < 0.0f;
     
-    // Render the enemy with texture if available, otherwise use solid color
-    if (enemyTex && enemyTex->textureID != 0) {
+    // Render the enemy with its sprite if available, otherwise use solid color
+    if (renderer->GetSprite(enemySprite)) {
         // Scale up 4x, use white color to preserve original texture colors
         // No rotation (0.0f) to keep level with screen, flip based on direction
-        renderer->DrawSpriteWorld(position, size * 4.0f, 0.0f, Colors::WHITE, enemyTex, facingLeft);
+        renderer->DrawSpriteWorld(enemySprite, position, size * 4.0f, 0.0f, Colors::WHITE, facingLeft);
     } else {
         // Fallback to solid color rendering
         renderer->DrawSpriteWorld(position, size, rotation, color, nullptr);
@@ -43,3 +43,8 @@ void BasicEnemy::Render(Renderer* renderer) {
     
     RenderHealthBar(renderer);
 }
+
+float BasicEnemy::GetRenderRadius() const {
+    // The textured sprite is drawn at 4x size
+    return std::max(size.x, size.y) * 3.0f;
+}
@@ -7,7 +7,8 @@ class BasicEnemy : public Enemy {
 public:
     BasicEnemy();
     void UpdateBehavior(float deltaTime, Game* game) override;
-    void Render(Renderer* renderer) override;
+    void Render(IRenderer* renderer) override;
+    float GetRenderRadius() const override;
 };
 
 #endif // BASIC_ENEMY_H
@@ -54,21 +54,13 @@ void BossEnemy::UpdateBehavior(float deltaTime, Game* game) {
     Enemy::MoveTowardsPlayer(deltaTime, game);
 }
 
-void BossEnemy::Render(Renderer* renderer) {
-    // Large boss body
-    renderer->DrawSpriteWorld(position, size, rotation, color, nullptr);
+void BossEnemy::Render(IRenderer* renderer) {
+    // Large boss body with its rotating ring and counter-rotating core
+    float pulsePhase = (g_Game ? g_Game->GetClockTime() : 0.0f) * 2.0f;
+    int prefab = g_Game ? g_Game->GetBossPrefab() : -1;
+    renderer->DrawPrefabWorld(prefab, position, size, rotation, color, pulsePhase);
     
-    // Outer ring
-    float pulsePhase = static_cast<float>(glfwGetTime()) * 2.0f;
-    float pulse = 0.9f + 0.1f * std::sin(pulsePhase);
-    glm::vec4 ringColor = glm::vec4(0.7f, 0.2f, 0.7f, 0.6f);
-    renderer->DrawSpriteWorld(position, size * 1.2f * pulse, rotation + pulsePhase * 0.5f, ringColor, nullptr);
-    
-    // Inner core
-    glm::vec4 coreColor = glm::vec4(1.0f, 0.3f, 1.0f, 1.0f);
-    renderer->DrawSpriteWorld(position, size * 0.4f, -rotation * 2.0f, coreColor, nullptr);
-    
-    // Phase indicator
+    // Phase indicator (sprites sort after prefabs, so these stay over the ring)
     for (int i = 0; i < phase; ++i) {
         float orbitAngle = pulsePhase + (glm::two_pi<float>() / 3.0f) * i;
         glm::vec2 orbitPos = position + glm::vec2(std::cos(orbitAngle), std::sin(orbitAngle)) * size.x * 0.6f;
@@ -77,3 +69,18 @@ void BossEnemy::Render(Renderer* renderer) {
     
     RenderHealthBar(renderer);
 }
+
+int BossEnemy::CreatePrefab(IRenderer* renderer) {
+    const glm::vec4 ringColor = glm::vec4(0.7f, 0.2f, 0.7f, 0.6f);
+    const glm::vec4 coreColor = glm::vec4(1.0f, 0.3f, 1.0f, 1.0f);
+    return renderer->CreatePrefab({
+        { glm::vec2(0.0f), glm::vec2(1.0f), 0.0f, Colors::WHITE, true, 0.0f },      // Body (boss color)
+        { glm::vec2(0.0f), glm::vec2(1.2f), 0.0f, ringColor, false, 0.5f },         // Outer ring
+        { glm::vec2(0.0f), glm::vec2(0.4f), 0.0f, coreColor, false, -1.0f },        // Inner core
+    });
+}
+
+float BossEnemy::GetRenderRadius() const {
+    // Rotating outer ring (1.2x size) and the orbiting phase indicators
+    return std::max(size.x, size.y) * 0.9f;
+}
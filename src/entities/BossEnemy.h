@@ -11,7 +11,11 @@ public:
     
     BossEnemy();
     void UpdateBehavior(float deltaTime, Game* game) override;
-    void Render(Renderer* renderer) override;
+    void Render(IRenderer* renderer) override;
+    float GetRenderRadius() const override;
+    
+    // Body, ring and core mesh, in units of the boss size (-1 on failure)
+    static int CreatePrefab(IRenderer* renderer);
 };
 
 #endif // BOSS_ENEMY_H
@@ -27,7 +27,7 @@ void Enemy::Update(float deltaTime, Game* game) {
     Entity::Update(deltaTime, game);
 }
 
-void Enemy::Render(Renderer* renderer) {
+void Enemy::Render(IRenderer* renderer) {
     Entity::Render(renderer);
     RenderHealthBar(renderer);
 }
@@ -81,7 +81,7 @@ void Enemy::MoveTowardsPlayer(float deltaTime, Game* game) {
     rotation = Utils::Angle(direction) + glm::half_pi<float>();
 }
 
-void Enemy::RenderHealthBar(Renderer* renderer) {
+void Enemy::RenderHealthBar(IRenderer* renderer) {
     if (health >= maxHealth) return;
     
     float barWidth = size.x * 1.2f;
@@ -93,10 +93,14 @@ void Enemy::RenderHealthBar(Renderer* renderer) {
     
     float healthPercent = health / maxHealth;
     
-    // Background
-    renderer->DrawRect(barPos, glm::vec2(barWidth, barHeight), glm::vec4(0.2f, 0.2f, 0.2f, 0.8f));
+    // Bars go over every enemy, not just their own
+    RenderLayer enemyLayer = renderer->GetLayer();
+    renderer->SetLayer(RenderLayer::ENEMY_OVERLAY);
     
-    // Health fill
+    // Batched with every other bar in the layer, so damaged enemies add no draw calls
     glm::vec4 healthColor = Utils::Lerp(Colors::RED, Colors::GREEN, healthPercent);
-    renderer->DrawRect(barPos, glm::vec2(barWidth * healthPercent, barHeight), healthColor);
+    renderer->DrawHealthBar(barPos, glm::vec2(barWidth, barHeight), healthPercent, healthColor,
+                            glm::vec4(0.2f, 0.2f, 0.2f, 0.8f));
+    
+    renderer->SetLayer(enemyLayer);
 }
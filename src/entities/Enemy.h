@@ -16,7 +16,7 @@ public:
     Enemy();
     
     void Update(float deltaTime, Game* game) override;
-    void Render(Renderer* renderer) override;
+    void Render(IRenderer* renderer) override;
     void OnCollision(Entity* other, Game* game) override;
     
     virtual void UpdateBehavior(float deltaTime, Game* game);
@@ -24,7 +24,7 @@ public:
     
 protected:
     void MoveTowardsPlayer(float deltaTime, Game* game);
-    void RenderHealthBar(Renderer* renderer);
+    void RenderHealthBar(IRenderer* renderer);
 };
 
 #endif // ENEMY_H
@@ -19,10 +19,15 @@ void Entity::Update(float deltaTime, Game* game) {
     position += velocity * deltaTime;
 }
 
-void Entity::Render(Renderer* renderer) {
+void Entity::Render(IRenderer* renderer) {
     renderer->DrawSpriteWorld(position, size, rotation, color, nullptr);
 }
 
+float Entity::GetRenderRadius() const {
+    // Half diagonal of the sprite, so any rotation is covered
+    return std::max(size.x, size.y) * 0.75f;
+}
+
 void Entity::OnCollision(Entity* other, Game* game) {
     (void)other;
     (void)game;
@@ -27,9 +27,12 @@ public:
     virtual ~Entity() = default;
     
     virtual void Update(float deltaTime, Game* game);
-    virtual void Render(Renderer* renderer);
+    virtual void Render(IRenderer* renderer);
     virtual void OnCollision(Entity* other, Game* game);
     
+    // Radius around position that Render may touch (glows, trails); used for culling
+    virtual float GetRenderRadius() const;
+    
     bool CollidesWith(Entity* other) const;
     float DistanceTo(Entity* other) const;
     float DistanceTo(const glm::vec2& point) const;
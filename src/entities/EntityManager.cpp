@@ -9,10 +9,14 @@
 #include "BossEnemy.h"
 #include "../game.h"
 #include "../utils.h"
+#include "../profiler.h"
 #include <algorithm>
 #include <limits>
 
-EntityManager::EntityManager() {
+EntityManager::EntityManager()
+    : enemiesSpawned(0)
+    , enemiesDied(0)
+{
 }
 
 void EntityManager::Update(float deltaTime, Game* game) {
@@ -52,34 +56,50 @@ void EntityManager::Update(float deltaTime, Game* game) {
     CleanupDeadEntities();
 }
 
-void EntityManager::Render(Renderer* renderer) {
+namespace {
+    // Extra margin for overlays drawn outside GetRenderRadius (enemy health bars)
+    const float CULL_MARGIN = 16.0f;
+    
+    bool InView(IRenderer* renderer, const Entity& entity) {
+        return renderer->IsVisible(entity.position, entity.GetRenderRadius() + CULL_MARGIN);
+    }
+}
+
+void EntityManager::Render(IRenderer* renderer) {
+    // Off-screen entities are skipped; the player is always in view
+    
     // Render XP orbs (behind everything else)
+    renderer->SetLayer(RenderLayer::PICKUPS);
     for (auto& orb : xpOrbs) {
-        if (orb->active) {
+        if (orb->active && InView(renderer, *orb)) {
             orb->Render(renderer);
         }
     }
     
     // Render enemies
+    renderer->SetLayer(RenderLayer::ENEMIES);
     for (auto& enemy : enemies) {
-        if (enemy->active) {
+        if (enemy->active && InView(renderer, *enemy)) {
             enemy->Render(renderer);
         }
     }
     
     // Render player
+    renderer->SetLayer(RenderLayer::PLAYER);
     if (player) {
         player->Render(renderer);
     }
     
     // Render projectiles
+    renderer->SetLayer(RenderLayer::PROJECTILES);
     for (auto& projectile : projectiles) {
-        if (projectile->active) {
+        if (projectile->active && InView(renderer, *projectile)) {
             projectile->Render(renderer);
         }
     }
     
     // Render particles (on top)
+    renderer->SetLayer(RenderLayer::EFFECTS);
     particleSystem.Render(renderer);
 }
 
@@ -112,6 +132,7 @@ Enemy* EntityManager::SpawnEnemy(EntityType enemyType, const glm::vec2& position
     enemy->position = position;
     Enemy* ptr = enemy.get();
     enemies.push_back(std::move(enemy));
+    enemiesSpawned++;
     return ptr;
 }
 
@@ -184,7 +205,17 @@ int EntityManager::GetProjectileCount() const {
     return count;
 }
 
+int EntityManager::GetXPOrbCount() const {
+    int count = 0;
+    for (const auto& orb : xpOrbs) {
+        if (orb->active && !orb->markedForDeletion) count++;
+    }
+    return count;
+}
+
 void EntityManager::UpdateCollisions(Game* game) {
+    PROFILE_ZONE("Collisions");
+    
     CheckProjectileEnemyCollisions(game);
     CheckPlayerEnemyCollisions(game);
     CheckPlayerXPCollisions(game);
@@ -241,11 +272,13 @@ void EntityManager::CheckPlayerXPCollisions(Game* game) {
 
 void EntityManager::CleanupDeadEntities() {
     // Remove dead enemies
+    size_t enemiesBefore = enemies.size();
     enemies.erase(
         std::remove_if(enemies.begin(), enemies.end(),
             [](const std::unique_ptr<Enemy>& e) { return e->markedForDeletion; }),
         enemies.end()
     );
+    enemiesDied += static_cast<uint32_t>(enemiesBefore - enemies.size());
     
     // Remove dead projectiles
     projectiles.erase(
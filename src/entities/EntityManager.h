@@ -26,10 +26,14 @@ public:
     std::vector<std::unique_ptr<XPOrb>> xpOrbs;
     ParticleSystem particleSystem;
     
+    // Running totals for metrics (never reset, take differences per frame)
+    uint32_t enemiesSpawned;
+    uint32_t enemiesDied;
+    
     EntityManager();
     
     void Update(float deltaTime, Game* game);
-    void Render(Renderer* renderer);
+    void Render(IRenderer* renderer);
     
     // Entity spawning
     void SpawnPlayer(const glm::vec2& position);
@@ -43,6 +47,7 @@ public:
     std::vector<Enemy*> FindEnemiesInRange(const glm::vec2& position, float range);
     int GetEnemyCount() const;
     int GetProjectileCount() const;
+    int GetXPOrbCount() const;
     
     // Cleanup
     void CleanupDeadEntities();
@@ -65,7 +65,7 @@ void FastEnemy::UpdateBehavior(float deltaTime, Game* game) {
     rotation = Utils::Angle(direction) + glm::half_pi<float>();
 }
 
-void FastEnemy::Render(Renderer* renderer) {
+void FastEnemy::Render(IRenderer* renderer) {
     // Sleek fast enemy
     renderer->DrawSpriteWorld(position, size, rotation, color, nullptr);
     
@@ -79,3 +79,8 @@ void FastEnemy::Render(Renderer* renderer) {
     
     RenderHealthBar(renderer);
 }
+
+float FastEnemy::GetRenderRadius() const {
+    // Dodge trail is drawn one body length behind
+    return std::max(size.x, size.y) * 1.6f;
+}
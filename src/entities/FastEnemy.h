@@ -12,7 +12,8 @@ public:
     
     FastEnemy();
     void UpdateBehavior(float deltaTime, Game* game) override;
-    void Render(Renderer* renderer) override;
+    void Render(IRenderer* renderer) override;
+    float GetRenderRadius() const override;
 };
 
 #endif // FAST_ENEMY_H
@@ -41,7 +41,7 @@ void Particle::Update(float deltaTime, Game* game) {
     Entity::Update(deltaTime, game);
 }
 
-void Particle::Render(Renderer* renderer) {
+void Particle::Render(IRenderer* renderer) {
     if (!active) return;
     renderer->DrawParticle(position, size.x, color);
 }
@@ -25,7 +25,7 @@ public:
     Particle();
     
     void Update(float deltaTime, Game* game) override;
-    void Render(Renderer* renderer) override;
+    void Render(IRenderer* renderer) override;
 };
 
 #endif // PARTICLE_H
@@ -8,7 +8,15 @@
 #include <glm/gtc/constants.hpp>
 #include <cmath>
 
-ParticleSystem::ParticleSystem() {
+ParticleSystem::ParticleSystem()
+    : gpuSimulated(false)
+    , gpuClearPending(false)
+    , gpuStagedCount(0)
+    , gpuCursor(0)
+    , gpuUsedSlots(0)
+    , gpuTime(0.0f)
+    , gpuPendingTime(0.0f)
+{
     particles.reserve(Constants::MAX_PARTICLES);
     for (int i = 0; i < Constants::MAX_PARTICLES; ++i) {
         particles.push_back(std::make_unique<Particle>());
@@ -16,6 +24,13 @@ ParticleSystem::ParticleSystem() {
 }
 
 void ParticleSystem::Update(float deltaTime, Game* game) {
+    if (gpuSimulated) {
+        // Stepped on the GPU when the particles are next rendered
+        gpuTime += deltaTime;
+        gpuPendingTime += deltaTime;
+        return;
+    }
+    
     for (auto& particle : particles) {
         if (particle->active) {
             particle->Update(deltaTime, game);
@@ -23,16 +38,71 @@ void ParticleSystem::Update(float deltaTime, Game* game) {
     }
 }
 
-void ParticleSystem::Render(Renderer* renderer) {
+void ParticleSystem::Render(IRenderer* renderer) {
+    if (gpuSimulated) {
+        RenderGpu(renderer);
+        return;
+    }
+    
     for (auto& particle : particles) {
-        if (particle->active) {
+        if (particle->active && renderer->IsVisible(particle->position, particle->size.x * 0.5f)) {
             particle->Render(renderer);
         }
     }
     renderer->FlushParticles();
 }
 
+void ParticleSystem::EnableGpuSimulation(int capacity) {
+    gpuSimulated = true;
+    gpuStaging.resize(GpuParticles::MAX_SPAWNS_PER_STEP);
+    gpuSpawns.resize(GpuParticles::MAX_SPAWNS_PER_STEP);
+    gpuSlotExpiry.assign(capacity, 0.0f);
+    gpuStagedCount = 0;
+    gpuCursor = 0;
+    gpuUsedSlots = 0;
+    
+    // The CPU pool is no longer used
+    particles.clear();
+}
+
+void ParticleSystem::RenderGpu(IRenderer* renderer) {
+    if (gpuClearPending) {
+        renderer->ClearGpuParticles();
+        gpuClearPending = false;
+    }
+    
+    // Spawns take GPU slots in ring order; record when each slot frees up
+    int capacity = static_cast<int>(gpuSlotExpiry.size());
+    for (int i = 0; i < gpuStagedCount; ++i) {
+        const Particle& p = gpuStaging[i];
+        GpuParticle& spawn = gpuSpawns[i];
+        spawn.position = p.position;
+        spawn.velocity = p.velocity;
+        spawn.age = 0.0f;
+        spawn.lifetime = p.maxLifetime;
+        spawn.drag = p.drag;
+        spawn.startSize = p.startSize;
+        spawn.endSize = p.endSize;
+        spawn.startColor = p.startColor;
+        spawn.endColor = p.endColor;
+        
+        gpuSlotExpiry[gpuCursor] = gpuTime + p.maxLifetime;
+        gpuCursor = (gpuCursor + 1) % capacity;
+        gpuUsedSlots = std::min(gpuUsedSlots + 1, capacity);
+    }
+    
+    renderer->SimulateGpuParticles(gpuPendingTime, gpuSpawns.data(), gpuStagedCount);
+    renderer->DrawGpuParticles();
+    gpuStagedCount = 0;
+    gpuPendingTime = 0.0f;
+}
+
 Particle* ParticleSystem::GetAvailableParticle() {
+    if (gpuSimulated) {
+        if (gpuStagedCount >= static_cast<int>(gpuStaging.size())) return nullptr;
+        return &gpuStaging[gpuStagedCount++];
+    }
+    
     for (auto& particle : particles) {
         if (!particle->active) {
             return particle.get();
@@ -145,9 +215,24 @@ void ParticleSystem::Clear() {
     for (auto& particle : particles) {
         particle->active = false;
     }
+    
+    if (gpuSimulated) {
+        gpuStagedCount = 0;
+        gpuCursor = 0;
+        gpuUsedSlots = 0;
+        gpuClearPending = true;
+    }
 }
 
 int ParticleSystem::GetActiveCount() const {
+    if (gpuSimulated) {
+        int count = 0;
+        for (int i = 0; i < gpuUsedSlots; ++i) {
+            if (gpuSlotExpiry[i] > gpuTime) count++;
+        }
+        return count;
+    }
+    
     int count = 0;
     for (const auto& particle : particles) {
         if (particle->active) count++;
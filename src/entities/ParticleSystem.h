@@ -21,7 +21,7 @@ public:
     ParticleSystem();
     
     void Update(float deltaTime, Game* game);
-    void Render(Renderer* renderer);
+    void Render(IRenderer* renderer);
     
     // Particle emitters
     void SpawnExplosion(const glm::vec2& position, const glm::vec4& color, int count = 20, float speed = 200.0f);
@@ -33,8 +33,26 @@ public:
     void Clear();
     int GetActiveCount() const;
     
+    // Hand simulation to the renderer's GPU particles (see Renderer::InitGpuParticles).
+    // Emitters then fill staging particles that are uploaded as spawns each frame.
+    void EnableGpuSimulation(int capacity);
+    bool IsGpuSimulated() const { return gpuSimulated; }
+
 private:
     Particle* GetAvailableParticle();
+    void RenderGpu(IRenderer* renderer);
+    
+    // GPU simulation state
+    bool gpuSimulated;
+    bool gpuClearPending;
+    std::vector<Particle> gpuStaging;       // Filled by emitters during the frame
+    int gpuStagedCount;
+    std::vector<GpuParticle> gpuSpawns;
+    std::vector<float> gpuSlotExpiry;       // Mirrors the GPU slot ring so counts need no readback
+    int gpuCursor;
+    int gpuUsedSlots;
+    float gpuTime;                          // Simulation clock of the GPU particles
+    float gpuPendingTime;                   // Time not yet stepped on the GPU
 };
 
 #endif // PARTICLESYSTEM_H
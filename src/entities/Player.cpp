@@ -69,7 +69,7 @@ void Player::UpdateMovement(float deltaTime) {
     }
 }
 
-void Player::Render(Renderer* renderer) {
+void Player::Render(IRenderer* renderer) {
     // Render engine trail first (behind ship)
     RenderEngineTrail(renderer);
     
@@ -77,42 +77,37 @@ void Player::Render(Renderer* renderer) {
     RenderShip(renderer);
 }
 
-void Player::RenderShip(Renderer* renderer) {
+void Player::RenderShip(IRenderer* renderer) {
     // Flash when invincible
     if (IsInvincible()) {
         float flash = std::sin(invincibilityTimer * 20.0f) * 0.5f + 0.5f;
         if (flash < 0.3f) return; // Skip rendering some frames for flashing effect
     }
     
-    // Main ship body (triangle-ish shape using rotated quad)
-    glm::vec4 shipColor = color;
-    renderer->DrawSpriteWorld(position, size, rotation, shipColor, nullptr);
-    
-    // Cockpit (smaller, brighter)
-    glm::vec4 cockpitColor = glm::vec4(0.5f, 0.8f, 1.0f, 1.0f);
-    glm::vec2 cockpitOffset = Utils::RotateVector(glm::vec2(0.0f, -size.y * 0.15f), rotation);
-    renderer->DrawSpriteWorld(position + cockpitOffset, size * 0.3f, rotation, cockpitColor, nullptr);
-    
-    // Wings
-    glm::vec4 wingColor = glm::vec4(0.2f, 0.4f, 0.7f, 1.0f);
-    glm::vec2 leftWingOffset = Utils::RotateVector(glm::vec2(-size.x * 0.4f, size.y * 0.1f), rotation);
-    glm::vec2 rightWingOffset = Utils::RotateVector(glm::vec2(size.x * 0.4f, size.y * 0.1f), rotation);
-    renderer->DrawSpriteWorld(position + leftWingOffset, size * glm::vec2(0.3f, 0.5f), rotation, wingColor, nullptr);
-    renderer->DrawSpriteWorld(position + rightWingOffset, size * glm::vec2(0.3f, 0.5f), rotation, wingColor, nullptr);
+    int prefab = g_Game ? g_Game->GetPlayerPrefab() : -1;
+    renderer->DrawPrefabWorld(prefab, position, size, rotation, color);
 }
 
-void Player::RenderEngineTrail(Renderer* renderer) {
+int Player::CreatePrefab(IRenderer* renderer) {
+    const glm::vec4 cockpitColor = glm::vec4(0.5f, 0.8f, 1.0f, 1.0f);
+    const glm::vec4 wingColor = glm::vec4(0.2f, 0.4f, 0.7f, 1.0f);
+    return renderer->CreatePrefab({
+        { glm::vec2(0.0f), glm::vec2(1.0f), 0.0f, Colors::WHITE, true, 0.0f },              // Body (ship color)
+        { glm::vec2(0.0f, -0.15f), glm::vec2(0.3f), 0.0f, cockpitColor, false, 0.0f },      // Cockpit
+        { glm::vec2(-0.4f, 0.1f), glm::vec2(0.3f, 0.5f), 0.0f, wingColor, false, 0.0f },    // Left wing
+        { glm::vec2(0.4f, 0.1f), glm::vec2(0.3f, 0.5f), 0.0f, wingColor, false, 0.0f },     // Right wing
+    });
+}
+
+void Player::RenderEngineTrail(IRenderer* renderer) {
     // Engine glow behind ship
     glm::vec2 engineOffset = Utils::RotateVector(glm::vec2(0.0f, size.y * 0.5f), rotation);
     glm::vec2 enginePos = position + engineOffset;
     
-    // Main engine glow
+    // Main engine glow with a hot center
     glm::vec4 glowColor = glm::vec4(0.3f, 0.5f, 1.0f, 0.6f * engineGlow);
-    renderer->DrawSpriteWorld(enginePos, size * 0.4f * engineGlow, rotation, glowColor, nullptr);
-    
-    // Hot center
-    glm::vec4 hotColor = glm::vec4(0.8f, 0.9f, 1.0f, 0.8f * engineGlow);
-    renderer->DrawSpriteWorld(enginePos, size * 0.2f * engineGlow, rotation, hotColor, nullptr);
+    float radius = size.x * 0.1f * engineGlow;
+    renderer->DrawGlowWorld(enginePos, radius, radius, glowColor, 0.5f);
 }
 
 void Player::TakeDamage(float damage, Game* game) {
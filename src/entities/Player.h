@@ -36,7 +36,7 @@ public:
     Player();
     
     void Update(float deltaTime, Game* game) override;
-    void Render(Renderer* renderer) override;
+    void Render(IRenderer* renderer) override;
     void OnCollision(Entity* other, Game* game) override;
     
     void TakeDamage(float damage, Game* game);
@@ -47,10 +47,13 @@ public:
     int GetExperienceForLevel(int lvl) const;
     bool IsInvincible() const { return invincibilityTimer > 0.0f; }
     
+    // Ship mesh, in units of the ship size (-1 on failure)
+    static int CreatePrefab(IRenderer* renderer);
+
 private:
     void UpdateMovement(float deltaTime);
-    void RenderShip(Renderer* renderer);
-    void RenderEngineTrail(Renderer* renderer);
+    void RenderShip(IRenderer* renderer);
+    void RenderEngineTrail(IRenderer* renderer);
 };
 
 #endif // PLAYER_H
@@ -74,7 +74,7 @@ void Projectile::UpdateTrail(float deltaTime) {
     }
 }
 
-void Projectile::Render(Renderer* renderer) {
+void Projectile::Render(IRenderer* renderer) {
     // Render trail
     for (size_t i = 0; i < trailPositions.size(); ++i) {
         float alpha = 1.0f - (float)i / trailPositions.size();
@@ -93,6 +93,15 @@ void Projectile::Render(Renderer* renderer) {
     renderer->DrawSpriteWorld(position, size * 0.5f, rotation, coreColor, nullptr);
 }
 
+float Projectile::GetRenderRadius() const {
+    // Cover the trail; its oldest point is the farthest from the projectile
+    float radius = Entity::GetRenderRadius();
+    if (!trailPositions.empty()) {
+        radius += Utils::Distance(position, trailPositions.back());
+    }
+    return radius;
+}
+
 void Projectile::OnCollision(Entity* other, Game* game) {
     if (isPlayerProjectile && (other->type == EntityType::ENEMY_BASIC ||
                                other->type == EntityType::ENEMY_TANK ||
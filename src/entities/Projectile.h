@@ -32,7 +32,8 @@ public:
     Projectile();
     
     void Update(float deltaTime, Game* game) override;
-    void Render(Renderer* renderer) override;
+    void Render(IRenderer* renderer) override;
+    float GetRenderRadius() const override;
     void OnCollision(Entity* other, Game* game) override;
     
     void SetHoming(float strength);
@@ -16,17 +16,20 @@ void TankEnemy::UpdateBehavior(float deltaTime, Game* game) {
     Enemy::MoveTowardsPlayer(deltaTime, game);
 }
 
-void TankEnemy::Render(Renderer* renderer) {
+void TankEnemy::Render(IRenderer* renderer) {
     // Large armored enemy
-    renderer->DrawSpriteWorld(position, size, rotation, color, nullptr);
-    
-    // Armor plates
-    glm::vec4 armorColor = glm::vec4(0.4f, 0.15f, 0.15f, 1.0f);
-    renderer->DrawSpriteWorld(position, size * 0.7f, rotation + 0.785f, armorColor, nullptr);
-    
-    // Core
-    glm::vec4 coreColor = glm::vec4(1.0f, 0.4f, 0.2f, 1.0f);
-    renderer->DrawSpriteWorld(position, size * 0.25f, rotation, coreColor, nullptr);
+    int prefab = g_Game ? g_Game->GetTankPrefab() : -1;
+    renderer->DrawPrefabWorld(prefab, position, size, rotation, color);
     
     RenderHealthBar(renderer);
 }
+
+int TankEnemy::CreatePrefab(IRenderer* renderer) {
+    const glm::vec4 armorColor = glm::vec4(0.4f, 0.15f, 0.15f, 1.0f);
+    const glm::vec4 coreColor = glm::vec4(1.0f, 0.4f, 0.2f, 1.0f);
+    return renderer->CreatePrefab({
+        { glm::vec2(0.0f), glm::vec2(1.0f), 0.0f, Colors::WHITE, true, 0.0f },      // Body (tank color)
+        { glm::vec2(0.0f), glm::vec2(0.7f), 0.785f, armorColor, false, 0.0f },      // Armor plates
+        { glm::vec2(0.0f), glm::vec2(0.25f), 0.0f, coreColor, false, 0.0f },        // Core
+    });
+}
@@ -7,7 +7,10 @@ class TankEnemy : public Enemy {
 public:
     TankEnemy();
     void UpdateBehavior(float deltaTime, Game* game) override;
-    void Render(Renderer* renderer) override;
+    void Render(IRenderer* renderer) override;
+    
+    // Body, armor and core mesh, in units of the tank size (-1 on failure)
+    static int CreatePrefab(IRenderer* renderer);
 };
 
 #endif // TANK_ENEMY_H
@@ -51,20 +51,18 @@ void XPOrb::Update(float deltaTime, Game* game) {
     Entity::Update(deltaTime, game);
 }
 
-void XPOrb::Render(Renderer* renderer) {
+void XPOrb::Render(IRenderer* renderer) {
     float pulse = 0.8f + 0.2f * std::sin(pulseTimer);
     glm::vec2 renderSize = size * pulse;
     
-    // Outer glow
-    glm::vec4 glowColor = color;
-    glowColor.a = 0.3f;
-    renderer->DrawSpriteWorld(position, renderSize * 1.5f, 0.0f, glowColor, nullptr);
-    
-    // Main orb
-    renderer->DrawSpriteWorld(position, renderSize, 0.0f, color, nullptr);
-    
-    // Bright center
-    glm::vec4 centerColor = Colors::WHITE;
-    centerColor.a = 0.8f;
-    renderer->DrawSpriteWorld(position, renderSize * 0.4f, 0.0f, centerColor, nullptr);
+    // Orb with an outer glow and a bright center, in one shape
+    float radius = renderSize.x * 0.5f;
+    renderer->DrawGlowWorld(position, radius, radius * 0.5f, color, 0.4f);
+}
+
+float XPOrb::GetRenderRadius() const {
+    // The glow reaches 0.75x size from the center at full pulse (radius 0.5x
+    // plus glow 0.25x); 1.1x keeps a margin so orbs at the screen edge are
+    // never culled while part of the glow is still visible
+    return std::max(size.x, size.y) * 1.1f;
 }
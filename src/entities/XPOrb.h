@@ -23,7 +23,8 @@ public:
     XPOrb(int value = 1);
     
     void Update(float deltaTime, Game* game) override;
-    void Render(Renderer* renderer) override;
+    void Render(IRenderer* renderer) override;
+    float GetRenderRadius() const override;
 };
 
 #endif // XPORB_H
@@ -4,6 +4,8 @@
 
 #include "game.h"
 #include <algorithm>
+#include <cstring>
+#include <filesystem>
 
 // Global game instance for callbacks
 Game* g_Game = nullptr;
@@ -16,11 +18,17 @@ Game::Game()
     : window(nullptr)
     , windowWidth(Constants::WINDOW_WIDTH)
     , windowHeight(Constants::WINDOW_HEIGHT)
+    , renderer(&glRenderer)
+    , enemySprite(-1)
+    , playerPrefab(-1)
+    , tankPrefab(-1)
+    , bossPrefab(-1)
     , gameState(GameState::MENU)
     , previousState(GameState::MENU)
     , gameTime(0.0f)
     , deltaTime(0.0f)
     , lastFrameTime(0.0f)
+    , headlessTime(0.0f)
     , spawnTimer(0.0f)
     , spawnRate(Constants::BASE_SPAWN_RATE)
     , difficultyTimer(0.0f)
@@ -32,7 +40,12 @@ Game::Game()
     , totalXPCollected(0)
     , selectedChoice(0)
     , numChoices(4)
+    , levelUpChoiceSet(0)
     , showDebugInfo(false)
+    , debugLineCount(0)
+    , debugRefreshTick(-1)
+    , lastEnemiesSpawned(0)
+    , lastEnemiesDied(0)
 {
     std::memset(keys, 0, sizeof(keys));
     std::memset(keysPressed, 0, sizeof(keysPressed));
@@ -49,8 +62,51 @@ Game::~Game() {
 // Initialization
 // ============================================================================
 
-bool Game::Initialize() {
+bool Game::Initialize(const GameOptions& gameOptions) {
     g_Game = this;
+    options = gameOptions;
+    
+    if (!options.metricsPath.empty()) {
+        metrics.Start(options.metricsPath, options.headless);
+    }
+    
+    // Headless runs skip the window. Offscreen runs render through GL all the
+    // same; the others have no GL at all, so the camera and culling (and the
+    // render code, when the run times it) go to a back end without it
+    if (options.headless) {
+        Utils::SeedRNG(options.seed);
+        std::cout << "Running headless (" << options.headlessFrames << " frames, seed " << options.seed << ")" << std::endl;
+        
+        if (options.offscreen) {
+            windowWidth = options.offscreenWidth;
+            windowHeight = options.offscreenHeight;
+            if (!offscreen.Initialize(windowWidth, windowHeight) || !InitializeRendering()) {
+                std::cerr << "Failed to initialize offscreen rendering" << std::endl;
+                return false;
+            }
+            if (options.renderThread) {
+                std::cerr << "Warning: --render-thread is ignored offscreen" << std::endl;
+            }
+            if (options.nullRender || options.recordDraws) {
+                std::cerr << "Warning: --null-render and --record-draws are ignored offscreen" << std::endl;
+            }
+            if (!options.frameDumpDir.empty()) {
+                std::error_code error;
+                std::filesystem::create_directories(options.frameDumpDir, error);
+            }
+        } else {
+            nullRenderer.Initialize(windowWidth, windowHeight);
+            recordingRenderer.Initialize(windowWidth, windowHeight);
+            if (options.recordDraws) {
+                renderer = &recordingRenderer;
+            } else {
+                renderer = &nullRenderer;
+            }
+            g_Renderer = renderer;
+            CreatePrefabs();
+        }
+        return true;
+    }
     
     // Initialize GLFW
     if (!glfwInit()) {
@@ -84,32 +140,77 @@ bool Game::Initialize() {
     glfwSetMouseButtonCallback(window, MouseButtonCallback);
     glfwSetCursorPosCallback(window, CursorPosCallback);
     
+    if (!InitializeRendering()) {
+        return false;
+    }
+    
+    // Load high scores
+    LoadHighScores();
+    
+    std::cout << "Game initialized successfully!" << std::endl;
+    std::cout << "Press SPACE or ENTER to start" << std::endl;
+    
+    if (options.traceAtStartup) {
+        g_Profiler.StartCapture(options.traceFrames, options.tracePath);
+    }
+    
+    // GL setup is done; from here on the render thread owns the context
+    if (options.renderThread) {
+        glRenderer.StartRenderThread(window);
+    }
+    
+    return true;
+}
+
+bool Game::InitializeRendering() {
     // Initialize renderer
-    if (!renderer.Initialize(windowWidth, windowHeight)) {
+    if (!glRenderer.Initialize(windowWidth, windowHeight)) {
         std::cerr << "Failed to initialize renderer" << std::endl;
         return false;
     }
     
-    g_Renderer = &renderer;
+    g_Renderer = renderer;
     
-    // Load textures
-    if (!enemyTexture.LoadFromFile("assets/textures/tie-fighter.png")) {
-        std::cerr << "Warning: Failed to load enemy texture, using solid colors" << std::endl;
+    if (options.gpuParticles) {
+        if (glRenderer.InitGpuParticles(Constants::MAX_GPU_PARTICLES)) {
+            entityManager.particleSystem.EnableGpuSimulation(Constants::MAX_GPU_PARTICLES);
+            std::cout << "GPU particle simulation enabled (" << Constants::MAX_GPU_PARTICLES << " particles)" << std::endl;
+        } else {
+            std::cerr << "Warning: GPU particles unavailable, simulating on the CPU" << std::endl;
+        }
     }
     
-    // Load high scores
-    LoadHighScores();
+    // Load sprites (packed into one atlas, so textured sprites share a texture)
+    if (!glRenderer.LoadSpriteAtlas("assets/textures")) {
+        std::cerr << "Warning: Failed to load sprites, using solid colors" << std::endl;
+    }
+    enemySprite = glRenderer.FindSprite("tie-fighter");
     
-    std::cout << "Game initialized successfully!" << std::endl;
-    std::cout << "Press SPACE or ENTER to start" << std::endl;
+    CreatePrefabs();
     
     return true;
 }
 
+void Game::CreatePrefabs() {
+    // Multi-part entities draw as one instance of their prefab
+    playerPrefab = Player::CreatePrefab(renderer);
+    tankPrefab = TankEnemy::CreatePrefab(renderer);
+    bossPrefab = BossEnemy::CreatePrefab(renderer);
+}
+
 void Game::Shutdown() {
-    SaveHighScores();
+    if (!options.headless) {
+        SaveHighScores();
+    }
+    
+    if (window || (options.headless && g_Game == this)) {
+        g_Profiler.StopCapture();
+        g_Profiler.PrintSummary(std::cout);
+    }
+    metrics.Stop();
     
-    renderer.Shutdown();
+    glRenderer.Shutdown();
+    offscreen.Shutdown();
     
     if (window) {
         glfwDestroyWindow(window);
@@ -128,8 +229,11 @@ void Game::Shutdown() {
 
 void Game::Run() {
     lastFrameTime = static_cast<float>(glfwGetTime());
+    g_Profiler.SetThreadName("Main");
     
     while (!glfwWindowShouldClose(window)) {
+        g_Profiler.BeginFrame();
+        
         // Calculate delta time
         float currentTime = static_cast<float>(glfwGetTime());
         deltaTime = currentTime - lastFrameTime;
@@ -139,25 +243,383 @@ void Game::Run() {
         deltaTime = std::min(deltaTime, 0.1f);
         
         // Process input
-        ProcessInput();
+        {
+            PROFILE_ZONE("Input");
+            ProcessInput();
+        }
         
         // Update
-        Update(deltaTime);
+        {
+            PROFILE_ZONE("Update");
+            Update(deltaTime);
+        }
         
         // Render
-        Render();
+        {
+            PROFILE_ZONE("Render");
+            Render();
+        }
         
-        // Swap buffers and poll events
-        glfwSwapBuffers(window);
+        // Swap buffers and poll events (a render thread presents its own frames)
+        if (!glRenderer.IsThreaded()) {
+            PROFILE_ZONE("Present");
+            glfwSwapBuffers(window);
+        }
         
         // Clear pressed keys/buttons for next frame
         std::memset(keysPressed, 0, sizeof(keysPressed));
         std::memset(mouseButtonsPressed, 0, sizeof(mouseButtonsPressed));
         
         glfwPollEvents();
+        
+        g_Profiler.EndFrame();
+        RecordFrameMetrics();
     }
 }
 
+void Game::RecordFrameMetrics() {
+    if (!metrics.IsRecording()) return;
+    
+    auto clampCount = [](int count) {
+        return static_cast<uint16_t>(Utils::Clamp(count, 0, 65535));
+    };
+    
+    const RenderStats& renderStats = renderer->GetStats();
+    
+    FrameRecord record;
+    record.frame = static_cast<uint32_t>(g_Profiler.GetFrameIndex() - 1);
+    record.gameTime = gameTime;
+    record.frameMs = static_cast<float>(g_Profiler.GetFrameStat().lastMs);
+    record.updateMs = static_cast<float>(g_Profiler.GetZoneMs("Update"));
+    record.renderMs = static_cast<float>(g_Profiler.GetZoneMs("Render"));
+    record.drawCalls = static_cast<uint32_t>(renderStats.drawCalls);
+    record.bytesUploaded = static_cast<uint32_t>(renderStats.bytesUploaded);
+    record.programSwitches = static_cast<uint32_t>(renderStats.programSwitches);
+    record.textureBinds = static_cast<uint32_t>(renderStats.textureBinds);
+    record.uniformUploads = static_cast<uint32_t>(renderStats.uniformUploads);
+    record.bufferUploads = static_cast<uint32_t>(renderStats.bufferUploads);
+    record.vertices = static_cast<uint32_t>(renderStats.vertices);
+    record.enemies = clampCount(entityManager.GetEnemyCount());
+    record.projectiles = clampCount(entityManager.GetProjectileCount());
+    record.orbs = clampCount(entityManager.GetXPOrbCount());
+    record.particles = clampCount(entityManager.particleSystem.GetActiveCount());
+    record.spawns = clampCount(static_cast<int>(entityManager.enemiesSpawned - lastEnemiesSpawned));
+    record.deaths = clampCount(static_cast<int>(entityManager.enemiesDied - lastEnemiesDied));
+    lastEnemiesSpawned = entityManager.enemiesSpawned;
+    lastEnemiesDied = entityManager.enemiesDied;
+    
+    metrics.Push(record);
+}
+
+// ============================================================================
+// Headless Mode
+// ============================================================================
+
+int Game::RunHeadless() {
+    const float dt = 1.0f / 60.0f;
+    const int warmupFrames = options.headlessFrames / 2;
+    
+    g_Profiler.SetThreadName("Main");
+    if (options.traceAtStartup) {
+        g_Profiler.StartCapture(options.traceFrames, options.tracePath);
+    }
+    
+    SetupHeadlessScenario();
+    
+    HeadlessResults results;
+    results.steadyFrames = options.headlessFrames - warmupFrames;
+    results.frameMs.reserve(results.steadyFrames);
+    std::vector<ProfileStat> warmupStats;
+    
+    // Offscreen runs render through GL; null and recording runs render without it
+    const bool rendering = offscreen.IsInitialized() || options.nullRender || options.recordDraws;
+    
+    char dumpPath[512];
+    for (int frame = 0; frame < options.headlessFrames; ++frame) {
+        g_Profiler.BeginFrame();
+        headlessTime = frame * dt;
+        
+        {
+            PROFILE_ZONE("Input");
+            UpdateHeadlessInput(headlessTime);
+        }
+        
+        {
+            PROFILE_ZONE("Update");
+            Update(dt);
+        }
+        
+        if (rendering) {
+            PROFILE_ZONE("Render");
+            Render();
+        }
+        
+        g_Profiler.EndFrame();
+        RecordFrameMetrics();
+        
+        // Outside the frame's zones: reading back waits for the GPU
+        if (!options.frameDumpDir.empty() && frame % options.frameDumpInterval == 0) {
+            snprintf(dumpPath, sizeof(dumpPath), "%s/frame_%05d.png", options.frameDumpDir.c_str(), frame);
+            offscreen.SavePng(dumpPath);
+        }
+        
+        if (frame == warmupFrames - 1) {
+            g_Profiler.GetCpuStats(warmupStats);
+        } else if (frame >= warmupFrames) {
+            const ProfileStat& frameStat = g_Profiler.GetFrameStat();
+            results.frameMs.push_back(frameStat.lastMs);
+            results.allocs += frameStat.lastAllocs;
+            results.peakAllocs = std::max(results.peakAllocs, frameStat.lastAllocs.count);
+            
+            // Timings resolve a frame or two late; close enough over a long run
+            const GpuTimer& gpuTimer = glRenderer.GetGpuTimer();
+            if (offscreen.IsInitialized() && gpuTimer.HasResults()) {
+                for (int pass = 0; pass < static_cast<int>(GpuPass::COUNT); ++pass) {
+                    results.gpuPassMs[pass] += gpuTimer.GetPassMs(static_cast<GpuPass>(pass));
+                }
+                results.gpuFrames++;
+            }
+            if (renderer == &recordingRenderer) {
+                for (int type = 0; type < static_cast<int>(RecordedDrawType::COUNT); ++type) {
+                    results.recordedDraws[type] += recordingRenderer.GetDrawCount(static_cast<RecordedDrawType>(type));
+                }
+            }
+        }
+    }
+    
+    std::cout << "Headless run finished: " << Utils::FormatTime(gameTime) << " survived, "
+              << entityManager.GetEnemyCount() << " enemies alive, player level "
+              << (entityManager.player ? entityManager.player->level : 1) << std::endl;
+    
+    // Per-zone figures cover only the steady-state part of the run
+    std::vector<ProfileStat> zoneStats;
+    g_Profiler.GetCpuStats(zoneStats);
+    for (ProfileStat stat : zoneStats) {
+        for (const auto& warm : warmupStats) {
+            if (std::strcmp(warm.name, stat.name) == 0) {
+                stat.totalMs -= warm.totalMs;
+                stat.totalAllocs = stat.totalAllocs - warm.totalAllocs;
+                stat.frames -= warm.frames;
+                break;
+            }
+        }
+        results.zones.push_back(stat);
+    }
+    
+    if (rendering) {
+        PrintRenderReport(results);
+    }
+    if (renderer == &recordingRenderer && !options.drawListPath.empty() &&
+        recordingRenderer.WriteDraws(options.drawListPath)) {
+        std::cout << "Draws of the last frame written to " << options.drawListPath << std::endl;
+    }
+    
+    int exitCode = 0;
+    if (options.allocCheck && !CheckAllocationBudget(results)) {
+        exitCode = 1;
+    }
+    
+    if (options.perfGate) {
+        // Runs that render time a different workload, so they get their own replay
+        char replay[96];
+        snprintf(replay, sizeof(replay), "late-game frames=%d seed=%u", options.headlessFrames, options.seed);
+        size_t length = std::strlen(replay);
+        if (offscreen.IsInitialized()) {
+            snprintf(replay + length, sizeof(replay) - length, " offscreen=%dx%d", windowWidth, windowHeight);
+        } else if (renderer == &recordingRenderer) {
+            snprintf(replay + length, sizeof(replay) - length, " render=record");
+        } else if (rendering) {
+            snprintf(replay + length, sizeof(replay) - length, " render=null");
+        }
+        std::vector<PerfMetric> metrics = CollectPerfMetrics(results);
+        if (options.perfUpdate) {
+            if (!Perf::WriteBaseline(options.perfBaseline, replay, metrics)) {
+                exitCode = 2;
+            }
+        } else {
+            exitCode = std::max(exitCode, Perf::RunGate(options.perfBaseline, replay, metrics, std::cout));
+        }
+    }
+    return exitCode;
+}
+
+void Game::SetupHeadlessScenario() {
+    StartNewGame();
+    
+    // Jump straight to a late-game loadout: every weapon, several upgrades,
+    // high difficulty and the fastest spawn rate
+    difficultyLevel = 10;
+    spawnRate = Constants::MIN_SPAWN_RATE;
+    
+    const WeaponType allWeapons[] = {
+        WeaponType::LASER, WeaponType::MISSILE, WeaponType::ORBITAL,
+        WeaponType::SHIELD, WeaponType::PLASMA, WeaponType::SPREAD
+    };
+    for (WeaponType type : allWeapons) {
+        weaponManager.AddWeapon(type);
+        for (int i = 0; i < 3; ++i) {
+            weaponManager.UpgradeWeapon(type);
+        }
+    }
+    
+    // The script should never die, so the whole run stays in the playing state
+    Player* player = entityManager.player.get();
+    player->maxHealth = 100000.0f;
+    player->health = player->maxHealth;
+    weaponManager.UpdateAllStats(player);
+}
+
+void Game::UpdateHeadlessInput(float time) {
+    switch (gameState) {
+        case GameState::PLAYING:
+            // Fly a slow figure eight so enemies keep streaming in from all sides
+            if (entityManager.player) {
+                entityManager.player->moveInput = glm::vec2(std::cos(time * 0.5f), std::sin(time));
+                entityManager.player->health = entityManager.player->maxHealth;
+            }
+            break;
+        
+        case GameState::LEVEL_UP:
+            ApplyUpgradeChoice(0);
+            break;
+        
+        default:
+            break;
+    }
+}
+
+bool Game::CheckAllocationBudget(const HeadlessResults& results) const {
+    if (!MemTrack::IsEnabled()) {
+        std::cerr << "Allocation check needs a build with ALLOC_TRACKING enabled" << std::endl;
+        return false;
+    }
+    if (results.steadyFrames <= 0) {
+        std::cerr << "Allocation check needs at least two headless frames" << std::endl;
+        return false;
+    }
+    
+    double frames = static_cast<double>(results.steadyFrames);
+    double avgAllocs = results.allocs.count / frames;
+    double avgBytes = results.allocs.bytes / frames;
+    bool averagePassed = avgAllocs <= options.allocBudget;
+    bool peakPassed = results.peakAllocs <= options.allocPeakBudget;
+    bool passed = averagePassed && peakPassed;
+    
+    char line[160];
+    std::cout << "Allocation check (" << results.steadyFrames << " steady-state frames)" << std::endl;
+    std::snprintf(line, sizeof(line), "  %-16s %10s %12s", "Zone", "allocs/fr", "bytes/fr");
+    std::cout << line << std::endl;
+    
+    for (const auto& stat : results.zones) {
+        if (stat.totalAllocs.count == 0) continue;
+        std::snprintf(line, sizeof(line), "  %-16s %10.2f %12.1f", stat.name,
+                      stat.totalAllocs.count / frames, stat.totalAllocs.bytes / frames);
+        std::cout << line << std::endl;
+    }
+    
+    std::snprintf(line, sizeof(line), "  %-16s %10.2f %12.1f   (budget %.2f)%s", "Frame",
+                  avgAllocs, avgBytes, options.allocBudget, averagePassed ? "" : "  OVER");
+    std::cout << line << std::endl;
+    std::snprintf(line, sizeof(line), "  %-16s %10llu %12s   (budget %.0f)%s", "Peak frame",
+                  static_cast<unsigned long long>(results.peakAllocs), "",
+                  options.allocPeakBudget, peakPassed ? "" : "  OVER");
+    std::cout << line << std::endl;
+    std::cout << (passed ? "Allocation check PASSED" : "Allocation check FAILED") << std::endl;
+    return passed;
+}
+
+void Game::PrintRenderReport(const HeadlessResults& results) const {
+    if (results.steadyFrames <= 0) return;
+    
+    double renderMs = 0.0;
+    for (const auto& stat : results.zones) {
+        if (std::strcmp(stat.name, "Render") == 0) {
+            renderMs = stat.totalMs / results.steadyFrames;
+        }
+    }
+    
+    const char* backend = offscreen.IsInitialized() ? "offscreen GL"
+                        : renderer == &recordingRenderer ? "recording" : "null";
+    char line[160];
+    std::cout << "Render cost (" << backend << " back end, " << windowWidth << "x" << windowHeight << ", "
+              << results.steadyFrames << " steady-state frames)" << std::endl;
+    std::snprintf(line, sizeof(line), "  %-20s %8.3f ms/frame", "CPU render", renderMs);
+    std::cout << line << std::endl;
+    
+    if (renderer == &recordingRenderer) {
+        uint64_t total = 0;
+        for (int type = 0; type < static_cast<int>(RecordedDrawType::COUNT); ++type) {
+            uint64_t count = results.recordedDraws[type];
+            if (count == 0) continue;
+            total += count;
+            std::snprintf(line, sizeof(line), "  %-20s %8.1f draws/frame",
+                          RecordingRenderer::GetDrawTypeName(static_cast<RecordedDrawType>(type)),
+                          static_cast<double>(count) / results.steadyFrames);
+            std::cout << line << std::endl;
+        }
+        std::snprintf(line, sizeof(line), "  %-20s %8.1f draws/frame", "Total",
+                      static_cast<double>(total) / results.steadyFrames);
+        std::cout << line << std::endl;
+    }
+    if (!offscreen.IsInitialized()) return;
+    
+    if (results.gpuFrames == 0) {
+        std::cout << "  GPU timings unavailable (no timer queries)" << std::endl;
+        return;
+    }
+    double gpuTotal = 0.0;
+    for (int pass = 0; pass < static_cast<int>(GpuPass::COUNT); ++pass) {
+        double ms = results.gpuPassMs[pass] / results.gpuFrames;
+        gpuTotal += ms;
+        std::snprintf(line, sizeof(line), "  GPU %-16s %8.3f ms/frame",
+                      GpuTimer::GetPassName(static_cast<GpuPass>(pass)), ms);
+        std::cout << line << std::endl;
+    }
+    std::snprintf(line, sizeof(line), "  %-20s %8.3f ms/frame", "GPU total", gpuTotal);
+    std::cout << line << std::endl;
+}
+
+std::vector<PerfMetric> Game::CollectPerfMetrics(const HeadlessResults& results) const {
+    std::vector<PerfMetric> metrics;
+    if (results.steadyFrames <= 0) return metrics;
+    
+    // Frame times: mean and 95th percentile of the steady-state frames
+    std::vector<double> sorted = results.frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    double mean = 0.0;
+    for (double ms : sorted) mean += ms;
+    mean /= sorted.size();
+    double p95 = sorted[std::min(sorted.size() - 1, sorted.size() * 95 / 100)];
+    
+    // Timings get generous tolerances (machines are noisy); allocation counts
+    // are deterministic for a given seed, so any real increase is flagged.
+    // Headless frames take a tenth of a millisecond and vary by tens of
+    // microseconds between runs, so the slack is sized to that, not to zero.
+    metrics.emplace_back("frame_ms_mean", mean, 0.25, 0.05);
+    metrics.emplace_back("frame_ms_p95", p95, 0.35, 0.05);
+    
+    for (const auto& stat : results.zones) {
+        if (stat.frames <= 0) continue;
+        std::string name = "zone_" + std::string(stat.name) + "_ms";
+        std::transform(name.begin(), name.end(), name.begin(), [](char c) {
+            return c == ' ' ? '_' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        });
+        metrics.emplace_back(name, stat.totalMs / results.steadyFrames, 0.30, 0.02);
+    }
+    
+    if (results.gpuFrames > 0) {
+        double gpuTotal = 0.0;
+        for (double ms : results.gpuPassMs) gpuTotal += ms;
+        metrics.emplace_back("gpu_frame_ms", gpuTotal / results.gpuFrames, 0.35, 0.01);
+    }
+    
+    if (MemTrack::IsEnabled()) {
+        metrics.emplace_back("allocs_per_frame", static_cast<double>(results.allocs.count) / results.steadyFrames, 0.05, 0.1);
+        metrics.emplace_back("alloc_bytes_per_frame", static_cast<double>(results.allocs.bytes) / results.steadyFrames, 0.10, 16.0);
+    }
+    return metrics;
+}
+
 // ============================================================================
 // Input Processing
 // ============================================================================
@@ -179,6 +641,11 @@ void Game::ProcessInput() {
         showDebugInfo = !showDebugInfo;
     }
     
+    // Trace capture of the next few hundred frames
+    if (keysPressed[GLFW_KEY_F5] && !g_Profiler.IsCapturing()) {
+        g_Profiler.StartCapture(options.traceFrames, options.tracePath);
+    }
+    
     // State-specific input
     switch (gameState) {
         case GameState::MENU:
@@ -263,7 +730,7 @@ void Game::Update(float dt) {
     }
     
     // Always update screen shake
-    renderer.UpdateScreenShake(dt);
+    renderer->UpdateScreenShake(dt);
 }
 
 void Game::UpdateMenuState(float dt) {
@@ -279,18 +746,27 @@ void Game::UpdatePlayingState(float dt) {
     UpdateDifficulty();
     
     // Spawn enemies
-    SpawnEnemies(dt);
+    {
+        PROFILE_ZONE("Spawning");
+        SpawnEnemies(dt);
+    }
     
     // Update all entities
-    entityManager.Update(dt, this);
+    {
+        PROFILE_ZONE("Entities");
+        entityManager.Update(dt, this);
+    }
     
     // Update weapons
-    weaponManager.Update(dt, this);
-    weaponManager.UpdateAllStats(entityManager.player.get());
+    {
+        PROFILE_ZONE("Weapons");
+        weaponManager.Update(dt, this);
+        weaponManager.UpdateAllStats(entityManager.player.get());
+    }
     
     // Update camera to follow player
     if (entityManager.player) {
-        renderer.SetCameraPosition(entityManager.player->position);
+        renderer->SetCameraPosition(entityManager.player->position);
     }
     
     // Check for player death
@@ -320,7 +796,7 @@ void Game::UpdateGameOverState(float dt) {
 // ============================================================================
 
 void Game::Render() {
-    renderer.BeginFrame();
+    renderer->BeginFrame();
     
     switch (gameState) {
         case GameState::MENU:
@@ -328,44 +804,47 @@ void Game::Render() {
             break;
         case GameState::PLAYING:
             RenderGame();
+            renderer->SetLayer(RenderLayer::HUD);
             RenderHUD();
             break;
         case GameState::LEVEL_UP:
             RenderGame();  // Show game in background
+            renderer->SetLayer(RenderLayer::MENU);
             RenderLevelUpMenu();
             break;
         case GameState::PAUSED:
             RenderGame();
+            renderer->SetLayer(RenderLayer::MENU);
             RenderPauseMenu();
             break;
         case GameState::GAME_OVER:
             RenderGame();
+            renderer->SetLayer(RenderLayer::MENU);
             RenderGameOver();
             break;
     }
     
     // Debug info
     if (showDebugInfo) {
-        std::string debugText = "FPS: " + std::to_string(static_cast<int>(1.0f / deltaTime));
-        debugText += "\nEntities: " + std::to_string(entityManager.GetEnemyCount());
-        debugText += "\nProjectiles: " + std::to_string(entityManager.GetProjectileCount());
-        debugText += "\nParticles: " + std::to_string(entityManager.particleSystem.GetActiveCount());
-        renderer.DrawText(debugText, glm::vec2(10, windowHeight - 80), 0.8f, Colors::WHITE);
+        renderer->SetLayer(RenderLayer::DEBUG);
+        RenderDebugInfo();
     }
     
-    renderer.EndFrame();
+    renderer->EndFrame();
 }
 
 void Game::RenderGame() {
     // Draw starfield background
-    renderer.DrawStarfield(static_cast<float>(glfwGetTime()));
+    renderer->SetLayer(RenderLayer::BACKGROUND);
+    renderer->DrawStarfield(GetClockTime());
     
-    // Render all entities
-    entityManager.Render(&renderer);
+    // Render all entities (each group in its own layer)
+    entityManager.Render(renderer);
     
     // Render weapon visuals (orbitals, shields, etc.)
+    renderer->SetLayer(RenderLayer::PROJECTILES);
     if (entityManager.player) {
-        weaponManager.Render(&renderer, entityManager.player->position);
+        weaponManager.Render(renderer, entityManager.player->position);
     }
 }
 
@@ -374,106 +853,247 @@ void Game::RenderHUD() {
     float barHeight = 20.0f;
     float barWidth = 200.0f;
     
+    // Labels are formatted and laid out again only when the value they show changes
+    char text[64];
+    
     // Health bar
     if (entityManager.player) {
         Player* player = entityManager.player.get();
         
         glm::vec2 healthBarPos(padding, padding);
         float healthPercent = player->health / player->maxHealth;
-        renderer.DrawProgressBar(healthBarPos, glm::vec2(barWidth, barHeight), healthPercent, 
+        renderer->DrawProgressBar(healthBarPos, glm::vec2(barWidth, barHeight), healthPercent, 
                                 Colors::HEALTH_RED, glm::vec4(0.2f, 0.2f, 0.2f, 0.8f));
         
         // Health text
-        std::string healthText = "HP: " + std::to_string(static_cast<int>(player->health)) + 
-                                "/" + std::to_string(static_cast<int>(player->maxHealth));
-        renderer.DrawText(healthText, glm::vec2(padding + barWidth + 10, padding + 2), 0.9f, Colors::WHITE);
+        int health = static_cast<int>(player->health);
+        int maxHealth = static_cast<int>(player->maxHealth);
+        if (hudHealthLabel.Changed(static_cast<long long>(health) << 32 | static_cast<unsigned int>(maxHealth))) {
+            snprintf(text, sizeof(text), "HP: %d/%d", health, maxHealth);
+            hudHealthLabel.SetText(*renderer, text, 0.9f);
+        }
+        hudHealthLabel.Draw(*renderer, glm::vec2(padding + barWidth + 10, padding + 2), Colors::WHITE);
         
         // XP bar
         glm::vec2 xpBarPos(padding, padding + barHeight + 10);
         float xpPercent = static_cast<float>(player->experience) / player->experienceToNextLevel;
-        renderer.DrawProgressBar(xpBarPos, glm::vec2(barWidth, barHeight * 0.7f), xpPercent,
+        renderer->DrawProgressBar(xpBarPos, glm::vec2(barWidth, barHeight * 0.7f), xpPercent,
                                 Colors::XP_GREEN, glm::vec4(0.2f, 0.2f, 0.2f, 0.8f));
         
         // Level text
-        std::string levelText = "Lv." + std::to_string(player->level);
-        renderer.DrawText(levelText, glm::vec2(padding + barWidth + 10, padding + barHeight + 10), 0.9f, Colors::YELLOW);
+        if (hudLevelLabel.Changed(player->level)) {
+            snprintf(text, sizeof(text), "Lv.%d", player->level);
+            hudLevelLabel.SetText(*renderer, text, 0.9f);
+        }
+        hudLevelLabel.Draw(*renderer, glm::vec2(padding + barWidth + 10, padding + barHeight + 10), Colors::YELLOW);
     }
     
-    // Timer (top center)
-    std::string timeText = Utils::FormatTime(gameTime);
-    float timeWidth = timeText.length() * 12.0f;
-    renderer.DrawText(timeText, glm::vec2((windowWidth - timeWidth) / 2, padding), 1.2f, Colors::WHITE);
+    // Timer (top center); the text only changes once per second
+    if (hudTimeLabel.Changed(static_cast<long long>(gameTime))) {
+        hudTimeLabel.SetText(*renderer, Utils::FormatTime(gameTime), 1.2f);
+    }
+    float timeWidth = hudTimeLabel.GetText().length() * 12.0f;
+    hudTimeLabel.Draw(*renderer, glm::vec2((windowWidth - timeWidth) / 2, padding), Colors::WHITE);
     
     // Kill count (top right)
-    std::string killText = "Kills: " + std::to_string(enemiesKilled);
-    float killWidth = killText.length() * 10.0f;
-    renderer.DrawText(killText, glm::vec2(windowWidth - killWidth - padding, padding), 0.9f, Colors::WHITE);
+    if (hudKillLabel.Changed(enemiesKilled)) {
+        snprintf(text, sizeof(text), "Kills: %d", enemiesKilled);
+        hudKillLabel.SetText(*renderer, text, 0.9f);
+    }
+    float killWidth = hudKillLabel.GetText().length() * 10.0f;
+    hudKillLabel.Draw(*renderer, glm::vec2(windowWidth - killWidth - padding, padding), Colors::WHITE);
     
-    // Weapon info (bottom left)
+    // Weapon info (bottom left); descriptions only change when a weapon levels up
+    int weaponCount = weaponManager.GetWeaponCount();
+    if (static_cast<int>(hudWeaponLabels.size()) < weaponCount) {
+        hudWeaponLabels.resize(weaponCount);
+    }
     float weaponY = windowHeight - padding - 20.0f;
-    for (int i = weaponManager.GetWeaponCount() - 1; i >= 0; --i) {
-        std::string weaponDesc = weaponManager.weapons[i]->GetDescription();
-        renderer.DrawText(weaponDesc, glm::vec2(padding, weaponY), 0.7f, Colors::CYAN);
+    for (int i = weaponCount - 1; i >= 0; --i) {
+        const Weapon* weapon = weaponManager.weapons[i].get();
+        if (hudWeaponLabels[i].Changed(static_cast<long long>(weapon->type) << 32 | weapon->level)) {
+            hudWeaponLabels[i].SetText(*renderer, weapon->GetDescription(), 0.7f);
+        }
+        hudWeaponLabels[i].Draw(*renderer, glm::vec2(padding, weaponY), Colors::CYAN);
         weaponY -= 18.0f;
     }
 }
 
+void Game::RenderDebugInfo() {
+    // Sampling and formatting every frame would cost more than most of what
+    // the overlay measures, so the text only changes a few times a second
+    long long tick = static_cast<long long>(GetClockTime() * DEBUG_REFRESH_RATE);
+    if (tick != debugRefreshTick) {
+        debugRefreshTick = tick;
+        debugLineCount = 0;
+        
+        char debugText[128];
+        snprintf(debugText, sizeof(debugText), "FPS: %d\nEntities: %d\nProjectiles: %d\nParticles: %d",
+                 static_cast<int>(1.0f / deltaTime), entityManager.GetEnemyCount(),
+                 entityManager.GetProjectileCount(), entityManager.particleSystem.GetActiveCount());
+        AddDebugLine(debugText, 0.8f, glm::vec2(10, windowHeight - 80), Colors::WHITE);
+        
+        LayoutProfilerOverlay();
+    }
+    
+    for (int i = 0; i < debugLineCount; ++i) {
+        const DebugLine& line = debugLines[i];
+        line.label.Draw(*renderer, line.position, line.color);
+    }
+}
+
+void Game::AddDebugLine(const char* text, float scale, const glm::vec2& position, const glm::vec4& color) {
+    if (debugLineCount == static_cast<int>(debugLines.size())) {
+        debugLines.emplace_back();
+    }
+    DebugLine& line = debugLines[debugLineCount++];
+    line.label.SetText(*renderer, text, scale);
+    line.position = position;
+    line.color = color;
+}
+
+void Game::LayoutProfilerOverlay() {
+    // CPU zones and GPU passes side by side, top right under the kill counter.
+    // With allocation tracking, CPU rows also show last frame's heap allocations.
+    bool showAllocs = MemTrack::IsEnabled();
+    float x = windowWidth - (showAllocs ? 380.0f : 320.0f);
+    float y = 70.0f;
+    float lineHeight = 20.0f;
+    char line[96];
+    
+    const ProfileStat& frame = g_Profiler.GetFrameStat();
+    if (showAllocs) {
+        snprintf(line, sizeof(line), "Frame  %6.2f ms  %4llu allocs %6.1f KB", frame.lastMs,
+                 static_cast<unsigned long long>(frame.lastAllocs.count), frame.lastAllocs.bytes / 1024.0);
+    } else {
+        snprintf(line, sizeof(line), "Frame  %6.2f ms", frame.lastMs);
+    }
+    AddDebugLine(line, 0.4f, glm::vec2(x, y), Colors::YELLOW);
+    y += lineHeight;
+    
+    g_Profiler.GetCpuStats(overlayStats);
+    for (const ProfileStat& stat : overlayStats) {
+        if (showAllocs) {
+            snprintf(line, sizeof(line), "CPU %-10s %6.2f ms  %4llu", stat.name, stat.avgMs,
+                     static_cast<unsigned long long>(stat.lastAllocs.count));
+        } else {
+            snprintf(line, sizeof(line), "CPU %-10s %6.2f ms", stat.name, stat.avgMs);
+        }
+        AddDebugLine(line, 0.4f, glm::vec2(x, y), Colors::WHITE);
+        y += lineHeight;
+    }
+    
+    g_Profiler.GetGpuStats(overlayStats);
+    for (const ProfileStat& stat : overlayStats) {
+        snprintf(line, sizeof(line), "GPU %-10s %6.2f ms", stat.name, stat.avgMs);
+        AddDebugLine(line, 0.4f, glm::vec2(x, y), Colors::CYAN);
+        y += lineHeight;
+    }
+    
+    // Renderer cost of the previous frame (includes this overlay)
+    const RenderStats& stats = renderer->GetStats();
+    y += lineHeight * 0.5f;
+    snprintf(line, sizeof(line), "Draws %5d   Verts %7d", stats.drawCalls, stats.vertices);
+    AddDebugLine(line, 0.4f, glm::vec2(x, y), Colors::MAGENTA);
+    y += lineHeight;
+    snprintf(line, sizeof(line), "Programs %4d   Textures %4d", stats.programSwitches, stats.textureBinds);
+    AddDebugLine(line, 0.4f, glm::vec2(x, y), Colors::MAGENTA);
+    y += lineHeight;
+    snprintf(line, sizeof(line), "Uniforms %5d", stats.uniformUploads);
+    AddDebugLine(line, 0.4f, glm::vec2(x, y), Colors::MAGENTA);
+    y += lineHeight;
+    snprintf(line, sizeof(line), "Uploads %5d   %7.1f KB   Orphans %d", stats.bufferUploads,
+             stats.bytesUploaded / 1024.0, stats.bufferOrphans);
+    AddDebugLine(line, 0.4f, glm::vec2(x, y), Colors::MAGENTA);
+    y += lineHeight;
+    snprintf(line, sizeof(line), "Visible %5d   Culled %5d", stats.visibleObjects, stats.culledObjects);
+    AddDebugLine(line, 0.4f, glm::vec2(x, y), Colors::MAGENTA);
+}
+
+void Game::SetFixedText(TextLabel& label, const char* text, float scale) {
+    if (label.Changed(0)) {
+        label.SetText(*renderer, text, scale);
+    }
+}
+
 void Game::RenderMenu() {
+    // Animated stars in background
+    renderer->SetLayer(RenderLayer::BACKGROUND);
+    renderer->DrawStarfield(GetClockTime());
+    
+    renderer->SetLayer(RenderLayer::MENU);
+    
     // Title
-    std::string title = "GALAXIES AWAY";
-    float titleWidth = title.length() * 20.0f;
-    renderer.DrawText(title, glm::vec2((windowWidth - titleWidth) / 2, 150), 2.0f, Colors::CYAN);
+    SetFixedText(menuTitleLabel, "GALAXIES AWAY", 2.0f);
+    float titleWidth = menuTitleLabel.GetText().length() * 20.0f;
+    menuTitleLabel.Draw(*renderer, glm::vec2((windowWidth - titleWidth) / 2, 150), Colors::CYAN);
     
     // Subtitle
-    std::string subtitle = "Space Roguelike Survival";
-    float subWidth = subtitle.length() * 10.0f;
-    renderer.DrawText(subtitle, glm::vec2((windowWidth - subWidth) / 2, 210), 1.0f, Colors::WHITE);
+    SetFixedText(menuSubtitleLabel, "Space Roguelike Survival", 1.0f);
+    float subWidth = menuSubtitleLabel.GetText().length() * 10.0f;
+    menuSubtitleLabel.Draw(*renderer, glm::vec2((windowWidth - subWidth) / 2, 210), Colors::WHITE);
     
     // Instructions
-    std::string startText = "Press SPACE or ENTER to Start";
-    float startWidth = startText.length() * 10.0f;
+    SetFixedText(menuStartLabel, "Press SPACE or ENTER to Start", 1.0f);
+    float startWidth = menuStartLabel.GetText().length() * 10.0f;
     
     // Pulsing effect
-    float pulse = 0.7f + 0.3f * std::sin(static_cast<float>(glfwGetTime()) * 3.0f);
+    float pulse = 0.7f + 0.3f * std::sin(GetClockTime() * 3.0f);
     glm::vec4 startColor = glm::vec4(1.0f, 1.0f, 1.0f, pulse);
-    renderer.DrawText(startText, glm::vec2((windowWidth - startWidth) / 2, 350), 1.0f, startColor);
+    menuStartLabel.Draw(*renderer, glm::vec2((windowWidth - startWidth) / 2, 350), startColor);
     
     // Controls
-    renderer.DrawText("CONTROLS:", glm::vec2(100, 450), 1.0f, Colors::YELLOW);
-    renderer.DrawText("WASD / Arrow Keys - Move", glm::vec2(100, 480), 0.8f, Colors::WHITE);
-    renderer.DrawText("Weapons fire automatically", glm::vec2(100, 510), 0.8f, Colors::WHITE);
-    renderer.DrawText("Collect green orbs for XP", glm::vec2(100, 540), 0.8f, Colors::WHITE);
-    renderer.DrawText("ESC - Pause", glm::vec2(100, 570), 0.8f, Colors::WHITE);
+    static const char* const controls[] = {
+        "WASD / Arrow Keys - Move",
+        "Weapons fire automatically",
+        "Collect green orbs for XP",
+        "ESC - Pause"
+    };
+    SetFixedText(menuControlsLabel, "CONTROLS:", 1.0f);
+    menuControlsLabel.Draw(*renderer, glm::vec2(100, 450), Colors::YELLOW);
+    for (int i = 0; i < 4; ++i) {
+        SetFixedText(menuControlLabels[i], controls[i], 0.8f);
+        menuControlLabels[i].Draw(*renderer, glm::vec2(100, 480 + i * 30), Colors::WHITE);
+    }
     
-    // High scores
+    // High scores; each line is bound to the time (in whole seconds, as shown) and level
     if (!highScores.empty()) {
-        renderer.DrawText("HIGH SCORES:", glm::vec2(windowWidth - 300, 450), 1.0f, Colors::YELLOW);
+        SetFixedText(menuScoresLabel, "HIGH SCORES:", 1.0f);
+        menuScoresLabel.Draw(*renderer, glm::vec2(windowWidth - 300, 450), Colors::YELLOW);
+        char text[64];
         for (size_t i = 0; i < std::min(highScores.size(), (size_t)5); ++i) {
-            std::string scoreText = std::to_string(i + 1) + ". " + 
-                                   Utils::FormatTime(highScores[i].survivalTime) + 
-                                   " Lv." + std::to_string(highScores[i].level);
-            renderer.DrawText(scoreText, glm::vec2(windowWidth - 300, 480 + i * 25), 0.8f, Colors::WHITE);
+            const HighScoreEntry& score = highScores[i];
+            long long seconds = static_cast<long long>(score.survivalTime);
+            if (menuScoreLabels[i].Changed(seconds << 32 | static_cast<unsigned int>(score.level))) {
+                snprintf(text, sizeof(text), "%d. %s Lv.%d", static_cast<int>(i + 1),
+                         Utils::FormatTime(score.survivalTime).c_str(), score.level);
+                menuScoreLabels[i].SetText(*renderer, text, 0.8f);
+            }
+            menuScoreLabels[i].Draw(*renderer, glm::vec2(windowWidth - 300, 480 + i * 25), Colors::WHITE);
         }
     }
     
-    // Animated stars in background
-    renderer.DrawStarfield(static_cast<float>(glfwGetTime()));
 }
 
 void Game::RenderLevelUpMenu() {
     // Dim background
-    renderer.DrawRect(glm::vec2(0, 0), glm::vec2(windowWidth, windowHeight), glm::vec4(0.0f, 0.0f, 0.0f, 0.7f));
+    renderer->DrawRect(glm::vec2(0, 0), glm::vec2(windowWidth, windowHeight), glm::vec4(0.0f, 0.0f, 0.0f, 0.7f));
     
     // Title
-    std::string title = "LEVEL UP!";
-    float titleWidth = title.length() * 20.0f;
-    renderer.DrawText(title, glm::vec2((windowWidth - titleWidth) / 2, 100), 2.0f, Colors::YELLOW);
+    SetFixedText(levelUpTitleLabel, "LEVEL UP!", 2.0f);
+    float titleWidth = levelUpTitleLabel.GetText().length() * 20.0f;
+    levelUpTitleLabel.Draw(*renderer, glm::vec2((windowWidth - titleWidth) / 2, 100), Colors::YELLOW);
+    
+    char text[64];
     
     // Level info
     if (entityManager.player) {
-        std::string levelText = "You reached Level " + std::to_string(entityManager.player->level);
-        float levelWidth = levelText.length() * 10.0f;
-        renderer.DrawText(levelText, glm::vec2((windowWidth - levelWidth) / 2, 160), 1.0f, Colors::WHITE);
+        if (levelUpLevelLabel.Changed(entityManager.player->level)) {
+            snprintf(text, sizeof(text), "You reached Level %d", entityManager.player->level);
+            levelUpLevelLabel.SetText(*renderer, text, 1.0f);
+        }
+        float levelWidth = levelUpLevelLabel.GetText().length() * 10.0f;
+        levelUpLevelLabel.Draw(*renderer, glm::vec2((windowWidth - levelWidth) / 2, 160), Colors::WHITE);
     }
     
     // Choices
@@ -482,100 +1102,129 @@ void Game::RenderLevelUpMenu() {
     float choiceHeight = 70.0f;
     float choiceX = (windowWidth - choiceWidth) / 2;
     
+    if (static_cast<int>(levelUpNumberLabels.size()) < numChoices) {
+        levelUpNumberLabels.resize(numChoices);
+        levelUpNameLabels.resize(numChoices);
+        levelUpDescriptionLabels.resize(numChoices);
+    }
+    
     for (int i = 0; i < numChoices && i < static_cast<int>(currentChoices.size()); ++i) {
         const UpgradeChoice& choice = currentChoices[i];
         
         // Background
         glm::vec4 bgColor = (i == selectedChoice) ? glm::vec4(0.3f, 0.5f, 0.8f, 0.8f) : glm::vec4(0.2f, 0.2f, 0.3f, 0.8f);
-        renderer.DrawRect(glm::vec2(choiceX, choiceY), glm::vec2(choiceWidth, choiceHeight), bgColor);
+        renderer->DrawRect(glm::vec2(choiceX, choiceY), glm::vec2(choiceWidth, choiceHeight), bgColor);
         
         // Selection indicator
         if (i == selectedChoice) {
-            renderer.DrawRectOutline(glm::vec2(choiceX, choiceY), glm::vec2(choiceWidth, choiceHeight), 3.0f, Colors::CYAN);
+            renderer->DrawRectOutline(glm::vec2(choiceX, choiceY), glm::vec2(choiceWidth, choiceHeight), 3.0f, Colors::CYAN);
         }
         
         // Choice number
-        std::string numText = std::to_string(i + 1) + ".";
-        renderer.DrawText(numText, glm::vec2(choiceX + 15, choiceY + 10), 1.0f, Colors::YELLOW);
+        if (levelUpNumberLabels[i].Changed(i)) {
+            snprintf(text, sizeof(text), "%d.", i + 1);
+            levelUpNumberLabels[i].SetText(*renderer, text, 1.0f);
+        }
+        levelUpNumberLabels[i].Draw(*renderer, glm::vec2(choiceX + 15, choiceY + 10), Colors::YELLOW);
         
-        // Choice name
-        renderer.DrawText(choice.name, glm::vec2(choiceX + 50, choiceY + 10), 1.0f, Colors::WHITE);
+        // Choice name and description, laid out again only for a new set of choices
+        if (levelUpNameLabels[i].Changed(levelUpChoiceSet)) {
+            levelUpNameLabels[i].SetText(*renderer, choice.name, 1.0f);
+        }
+        levelUpNameLabels[i].Draw(*renderer, glm::vec2(choiceX + 50, choiceY + 10), Colors::WHITE);
         
-        // Description
-        renderer.DrawText(choice.description, glm::vec2(choiceX + 50, choiceY + 40), 0.7f, glm::vec4(0.8f, 0.8f, 0.8f, 1.0f));
+        if (levelUpDescriptionLabels[i].Changed(levelUpChoiceSet)) {
+            levelUpDescriptionLabels[i].SetText(*renderer, choice.description, 0.7f);
+        }
+        levelUpDescriptionLabels[i].Draw(*renderer, glm::vec2(choiceX + 50, choiceY + 40), glm::vec4(0.8f, 0.8f, 0.8f, 1.0f));
         
         choiceY += choiceHeight + 15.0f;
     }
     
     // Instructions
-    std::string instructions = "Use W/S or 1-4 to select, SPACE/ENTER to confirm";
-    float instrWidth = instructions.length() * 8.0f;
-    renderer.DrawText(instructions, glm::vec2((windowWidth - instrWidth) / 2, windowHeight - 50), 0.8f, Colors::WHITE);
+    SetFixedText(levelUpHintLabel, "Use W/S or 1-4 to select, SPACE/ENTER to confirm", 0.8f);
+    float instrWidth = levelUpHintLabel.GetText().length() * 8.0f;
+    levelUpHintLabel.Draw(*renderer, glm::vec2((windowWidth - instrWidth) / 2, windowHeight - 50), Colors::WHITE);
 }
 
 void Game::RenderPauseMenu() {
     // Dim background
-    renderer.DrawRect(glm::vec2(0, 0), glm::vec2(windowWidth, windowHeight), glm::vec4(0.0f, 0.0f, 0.0f, 0.6f));
+    renderer->DrawRect(glm::vec2(0, 0), glm::vec2(windowWidth, windowHeight), glm::vec4(0.0f, 0.0f, 0.0f, 0.6f));
     
     // Pause text
-    std::string pauseText = "PAUSED";
-    float pauseWidth = pauseText.length() * 25.0f;
-    renderer.DrawText(pauseText, glm::vec2((windowWidth - pauseWidth) / 2, 250), 2.5f, Colors::WHITE);
+    SetFixedText(pauseTitleLabel, "PAUSED", 2.5f);
+    float pauseWidth = pauseTitleLabel.GetText().length() * 25.0f;
+    pauseTitleLabel.Draw(*renderer, glm::vec2((windowWidth - pauseWidth) / 2, 250), Colors::WHITE);
     
     // Options
-    std::string resumeText = "Press SPACE or ESC to Resume";
-    float resumeWidth = resumeText.length() * 10.0f;
-    renderer.DrawText(resumeText, glm::vec2((windowWidth - resumeWidth) / 2, 350), 1.0f, Colors::CYAN);
+    SetFixedText(pauseResumeLabel, "Press SPACE or ESC to Resume", 1.0f);
+    float resumeWidth = pauseResumeLabel.GetText().length() * 10.0f;
+    pauseResumeLabel.Draw(*renderer, glm::vec2((windowWidth - resumeWidth) / 2, 350), Colors::CYAN);
     
-    std::string quitText = "Press Q to Quit to Menu";
-    float quitWidth = quitText.length() * 10.0f;
-    renderer.DrawText(quitText, glm::vec2((windowWidth - quitWidth) / 2, 390), 1.0f, Colors::WHITE);
+    SetFixedText(pauseQuitLabel, "Press Q to Quit to Menu", 1.0f);
+    float quitWidth = pauseQuitLabel.GetText().length() * 10.0f;
+    pauseQuitLabel.Draw(*renderer, glm::vec2((windowWidth - quitWidth) / 2, 390), Colors::WHITE);
 }
 
 void Game::RenderGameOver() {
     // Dim background
-    renderer.DrawRect(glm::vec2(0, 0), glm::vec2(windowWidth, windowHeight), glm::vec4(0.0f, 0.0f, 0.0f, 0.8f));
+    renderer->DrawRect(glm::vec2(0, 0), glm::vec2(windowWidth, windowHeight), glm::vec4(0.0f, 0.0f, 0.0f, 0.8f));
     
     // Game over text
-    std::string gameOverText = "GAME OVER";
-    float goWidth = gameOverText.length() * 25.0f;
-    renderer.DrawText(gameOverText, glm::vec2((windowWidth - goWidth) / 2, 150), 2.5f, Colors::RED);
+    SetFixedText(gameOverTitleLabel, "GAME OVER", 2.5f);
+    float goWidth = gameOverTitleLabel.GetText().length() * 25.0f;
+    gameOverTitleLabel.Draw(*renderer, glm::vec2((windowWidth - goWidth) / 2, 150), Colors::RED);
     
     // Stats
     float statY = 260.0f;
     float statX = windowWidth / 2 - 150.0f;
+    char text[64];
     
-    renderer.DrawText("FINAL STATS", glm::vec2(statX, statY), 1.2f, Colors::YELLOW);
+    SetFixedText(gameOverStatsLabel, "FINAL STATS", 1.2f);
+    gameOverStatsLabel.Draw(*renderer, glm::vec2(statX, statY), Colors::YELLOW);
     statY += 40.0f;
     
-    std::string timeText = "Survival Time: " + Utils::FormatTime(gameTime);
-    renderer.DrawText(timeText, glm::vec2(statX, statY), 1.0f, Colors::WHITE);
+    if (gameOverTimeLabel.Changed(static_cast<long long>(gameTime))) {
+        snprintf(text, sizeof(text), "Survival Time: %s", Utils::FormatTime(gameTime).c_str());
+        gameOverTimeLabel.SetText(*renderer, text, 1.0f);
+    }
+    gameOverTimeLabel.Draw(*renderer, glm::vec2(statX, statY), Colors::WHITE);
     statY += 30.0f;
     
     if (entityManager.player) {
-        std::string levelText = "Final Level: " + std::to_string(entityManager.player->level);
-        renderer.DrawText(levelText, glm::vec2(statX, statY), 1.0f, Colors::WHITE);
+        if (gameOverLevelLabel.Changed(entityManager.player->level)) {
+            snprintf(text, sizeof(text), "Final Level: %d", entityManager.player->level);
+            gameOverLevelLabel.SetText(*renderer, text, 1.0f);
+        }
+        gameOverLevelLabel.Draw(*renderer, glm::vec2(statX, statY), Colors::WHITE);
         statY += 30.0f;
     }
     
-    std::string killText = "Enemies Defeated: " + std::to_string(enemiesKilled);
-    renderer.DrawText(killText, glm::vec2(statX, statY), 1.0f, Colors::WHITE);
+    if (gameOverKillLabel.Changed(enemiesKilled)) {
+        snprintf(text, sizeof(text), "Enemies Defeated: %d", enemiesKilled);
+        gameOverKillLabel.SetText(*renderer, text, 1.0f);
+    }
+    gameOverKillLabel.Draw(*renderer, glm::vec2(statX, statY), Colors::WHITE);
     statY += 30.0f;
     
-    std::string weaponText = "Weapons Acquired: " + std::to_string(weaponManager.GetWeaponCount());
-    renderer.DrawText(weaponText, glm::vec2(statX, statY), 1.0f, Colors::WHITE);
+    int weaponCount = weaponManager.GetWeaponCount();
+    if (gameOverWeaponLabel.Changed(weaponCount)) {
+        snprintf(text, sizeof(text), "Weapons Acquired: %d", weaponCount);
+        gameOverWeaponLabel.SetText(*renderer, text, 1.0f);
+    }
+    gameOverWeaponLabel.Draw(*renderer, glm::vec2(statX, statY), Colors::WHITE);
     statY += 50.0f;
     
     // Options
-    std::string retryText = "Press SPACE to Try Again";
-    float retryWidth = retryText.length() * 10.0f;
-    float pulse = 0.7f + 0.3f * std::sin(static_cast<float>(glfwGetTime()) * 3.0f);
-    renderer.DrawText(retryText, glm::vec2((windowWidth - retryWidth) / 2, statY), 1.0f, 
-                      glm::vec4(1.0f, 1.0f, 1.0f, pulse));
-    
-    std::string menuText = "Press Q for Menu";
-    float menuWidth = menuText.length() * 10.0f;
-    renderer.DrawText(menuText, glm::vec2((windowWidth - menuWidth) / 2, statY + 40), 0.9f, Colors::WHITE);
+    SetFixedText(gameOverRetryLabel, "Press SPACE to Try Again", 1.0f);
+    float retryWidth = gameOverRetryLabel.GetText().length() * 10.0f;
+    float pulse = 0.7f + 0.3f * std::sin(GetClockTime() * 3.0f);
+    gameOverRetryLabel.Draw(*renderer, glm::vec2((windowWidth - retryWidth) / 2, statY),
+                            glm::vec4(1.0f, 1.0f, 1.0f, pulse));
+    
+    SetFixedText(gameOverMenuLabel, "Press Q for Menu", 0.9f);
+    float menuWidth = gameOverMenuLabel.GetText().length() * 10.0f;
+    gameOverMenuLabel.Draw(*renderer, glm::vec2((windowWidth - menuWidth) / 2, statY + 40), Colors::WHITE);
 }
 
 // ============================================================================
@@ -607,7 +1256,7 @@ void Game::StartNewGame() {
     entityManager.SpawnPlayer(glm::vec2(0.0f));
     
     // Set camera
-    renderer.SetCameraPosition(glm::vec2(0.0f));
+    renderer->SetCameraPosition(glm::vec2(0.0f));
     
     SetState(GameState::PLAYING);
     
@@ -622,6 +1271,7 @@ void Game::SpawnEnemies(float dt) {
     spawnTimer -= dt;
     
     if (spawnTimer <= 0.0f) {
+        PROFILE_ZONE("Spawn Wave");
         spawnTimer = spawnRate;
         
         // Determine enemy type based on difficulty and randomness
@@ -661,7 +1311,8 @@ void Game::SpawnEnemies(float dt) {
         boss->damage *= (1.0f + bossesDefeated * 0.2f);
         
         // Screen shake for boss spawn
-        renderer.SetScreenShake(10.0f, 0.5f);
+        renderer->SetScreenShake(10.0f, 0.5f);
+        g_Profiler.Mark("Boss Spawn");
         
         std::cout << "Boss spawned!" << std::endl;
     }
@@ -676,6 +1327,7 @@ void Game::UpdateDifficulty() {
         
         // Increase spawn rate
         spawnRate = std::max(Constants::MIN_SPAWN_RATE, spawnRate * 0.9f);
+        g_Profiler.Mark("Difficulty Up");
         
         std::cout << "Difficulty increased to level " << difficultyLevel << std::endl;
     }
@@ -708,6 +1360,9 @@ glm::vec2 Game::GetRandomSpawnPosition() const {
 // ============================================================================
 
 void Game::OnPlayerLevelUp() {
+    PROFILE_ZONE("Level Up");
+    g_Profiler.Mark("Level Up");
+    
     GenerateLevelUpChoices();
     selectedChoice = 0;
     SetState(GameState::LEVEL_UP);
@@ -718,6 +1373,7 @@ void Game::OnPlayerLevelUp() {
 
 void Game::GenerateLevelUpChoices() {
     currentChoices.clear();
+    levelUpChoiceSet++;
     
     // Get all available upgrades
     std::vector<UpgradeChoice> allChoices = weaponManager.GetAvailableUpgrades();
@@ -774,7 +1430,7 @@ void Game::OnPlayerDeath() {
         entityManager.particleSystem.SpawnExplosion(entityManager.player->position, Colors::PLAYER_BLUE, 50, 300.0f);
     }
     
-    renderer.SetScreenShake(15.0f, 0.5f);
+    renderer->SetScreenShake(15.0f, 0.5f);
     
     SetState(GameState::GAME_OVER);
     
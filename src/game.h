@@ -10,6 +10,11 @@
 #include "renderer.h"
 #include "entities.h"
 #include "weapons.h"
+#include "profiler.h"
+#include "perf.h"
+#include "metrics.h"
+#include "offscreen.h"
+#include "render_backends.h"
 
 // ============================================================================
 // High Score Entry
@@ -24,6 +29,86 @@ struct HighScoreEntry {
     HighScoreEntry(float time, int lvl, int kills) : survivalTime(time), level(lvl), enemiesKilled(kills) {}
 };
 
+// ============================================================================
+// Launch Options (parsed from the command line in main.cpp)
+// ============================================================================
+
+struct GameOptions {
+    bool traceAtStartup;    // Begin a trace capture as soon as the game starts
+    int traceFrames;        // Frames recorded per capture (command line or F5)
+    std::string tracePath;
+    
+    // Headless mode: no window or GL context, scripted late-game simulation
+    bool headless;
+    int headlessFrames;     // Fixed 60 Hz steps; the second half counts as steady state
+    unsigned int seed;
+    
+    // Allocation check: fail the headless run if steady-state frames allocate too much
+    bool allocCheck;
+    double allocBudget;     // Average heap allocations allowed per steady-state frame;
+                            // tighten as spawns and weapons stop allocating
+    double allocPeakBudget; // Most heap allocations any single steady-state frame may make
+    
+    // Perf gate: compare the headless run against a checked-in baseline
+    bool perfGate;
+    bool perfUpdate;        // Record the run as the new baseline instead of comparing
+    std::string perfBaseline;
+    
+    // Per-frame metrics stream (empty path = not recording)
+    std::string metricsPath;
+    
+    // Simulate particles on the GPU with transform feedback (falls back to the CPU)
+    bool gpuParticles;
+    
+    // Record draws on the main thread and submit them to GL from a render thread
+    bool renderThread;
+    
+    // Offscreen mode: the headless run also renders, into a framebuffer on a
+    // windowless context, and reports CPU and GPU frame cost
+    bool offscreen;
+    int offscreenWidth, offscreenHeight;
+    std::string frameDumpDir;   // PNG frames for golden-image comparison (empty = none)
+    int frameDumpInterval;      // Every Nth frame is written
+    
+    // Headless runs without GL that still run the render code, to time it on
+    // its own: the null back end drops the draws, the recording one keeps them
+    bool nullRender;
+    bool recordDraws;
+    std::string drawListPath;   // Draws of the last frame, one per line (empty = not written)
+    
+    GameOptions()
+        : traceAtStartup(false), traceFrames(300), tracePath("trace.json")
+        , headless(false), headlessFrames(3600), seed(1234)
+        , allocCheck(false), allocBudget(6.0), allocPeakBudget(64.0)
+        , perfGate(false), perfUpdate(false), perfBaseline("perf/baseline.json")
+        , gpuParticles(false), renderThread(false)
+        , offscreen(false), offscreenWidth(Constants::WINDOW_WIDTH), offscreenHeight(Constants::WINDOW_HEIGHT)
+        , frameDumpInterval(60)
+        , nullRender(false), recordDraws(false) {}
+};
+
+// ============================================================================
+// Headless Run Results (steady-state half of the run)
+// ============================================================================
+
+struct HeadlessResults {
+    int steadyFrames;
+    std::vector<ProfileStat> zones;     // Per-zone totals over the steady-state frames
+    std::vector<double> frameMs;        // CPU time of each steady-state frame
+    AllocStats allocs;
+    uint64_t peakAllocs;
+    
+    // Offscreen runs only: GPU time per pass, summed over the steady-state
+    // frames whose timings had resolved
+    double gpuPassMs[static_cast<int>(GpuPass::COUNT)];
+    int gpuFrames;
+    
+    // Recording runs only: draws of each type, summed over the steady-state frames
+    uint64_t recordedDraws[static_cast<int>(RecordedDrawType::COUNT)];
+    
+    HeadlessResults() : steadyFrames(0), peakAllocs(0), gpuPassMs(), gpuFrames(0), recordedDraws() {}
+};
+
 // ============================================================================
 // Game Class
 // ============================================================================
@@ -34,11 +119,12 @@ public:
     ~Game();
     
     // Initialization
-    bool Initialize();
+    bool Initialize(const GameOptions& gameOptions = GameOptions());
     void Shutdown();
     
     // Main loop
     void Run();
+    int RunHeadless();      // Returns a process exit code
     
     // Callbacks from other systems
     void OnPlayerLevelUp();
@@ -49,13 +135,34 @@ public:
     WeaponManager* GetWeaponManager() { return &weaponManager; }
     GameState GetState() const { return gameState; }
     float GetGameTime() const { return gameTime; }
-    Texture* GetEnemyTexture() { return &enemyTexture; }
+    // Seconds since startup for animation; simulated time in headless runs,
+    // so offscreen frames come out the same on every machine
+    float GetClockTime() const { return window ? static_cast<float>(glfwGetTime()) : headlessTime; }
+    int GetEnemySprite() const { return enemySprite; }
+    int GetPlayerPrefab() const { return playerPrefab; }
+    int GetTankPrefab() const { return tankPrefab; }
+    int GetBossPrefab() const { return bossPrefab; }
+    // Atlas page holding the enemy sprite (null when it did not load)
+    Texture* GetEnemyTexture() {
+        const AtlasSprite* sprite = renderer->GetSprite(enemySprite);
+        return sprite ? sprite->page : nullptr;
+    }
     
 private:
     // Core loop
     void ProcessInput();
     void Update(float deltaTime);
     void Render();
+    void RecordFrameMetrics();
+    bool InitializeRendering();
+    void CreatePrefabs();
+    
+    // Headless mode
+    void SetupHeadlessScenario();
+    void UpdateHeadlessInput(float time);
+    bool CheckAllocationBudget(const HeadlessResults& results) const;
+    void PrintRenderReport(const HeadlessResults& results) const;
+    std::vector<PerfMetric> CollectPerfMetrics(const HeadlessResults& results) const;
     
     // State management
     void SetState(GameState newState);
@@ -83,6 +190,10 @@ private:
     void RenderPauseMenu();
     void RenderGameOver();
     void RenderHUD();
+    void RenderDebugInfo();
+    void LayoutProfilerOverlay();
+    void AddDebugLine(const char* text, float scale, const glm::vec2& position, const glm::vec4& color);
+    void SetFixedText(TextLabel& label, const char* text, float scale);
     
     // High scores
     void LoadHighScores();
@@ -98,11 +209,21 @@ private:
     GLFWwindow* window;
     int windowWidth, windowHeight;
     
-    // Renderer
-    Renderer renderer;
+    // Renderer: everything draws through renderer, which is the GL back end
+    // unless a headless run picked one without GL
+    Renderer glRenderer;
+    NullRenderer nullRenderer;
+    RecordingRenderer recordingRenderer;
+    IRenderer* renderer;
+    OffscreenTarget offscreen;  // Stands in for the window in offscreen runs
     
-    // Textures
-    Texture enemyTexture;
+    // Sprites in the renderer's atlas (-1 when missing)
+    int enemySprite;
+    
+    // Multi-part entity meshes in the renderer (-1 when missing)
+    int playerPrefab;
+    int tankPrefab;
+    int bossPrefab;
     
     // Game systems
     EntityManager entityManager;
@@ -116,6 +237,7 @@ private:
     float gameTime;         // Total time survived
     float deltaTime;
     float lastFrameTime;
+    float headlessTime;     // Simulated clock of headless runs
     
     // Enemy spawning
     float spawnTimer;
@@ -144,12 +266,66 @@ private:
     bool mouseButtons[GLFW_MOUSE_BUTTON_LAST + 1];
     bool mouseButtonsPressed[GLFW_MOUSE_BUTTON_LAST + 1];
     
+    // HUD text, re-laid out only when the bound value changes
+    TextLabel hudHealthLabel;
+    TextLabel hudLevelLabel;
+    TextLabel hudTimeLabel;
+    TextLabel hudKillLabel;
+    std::vector<TextLabel> hudWeaponLabels;
+    
+    // Menu, level-up, pause and game-over text. Fixed lines are laid out the
+    // first time they are drawn; lines that show a value are bound to it.
+    TextLabel menuTitleLabel;
+    TextLabel menuSubtitleLabel;
+    TextLabel menuStartLabel;
+    TextLabel menuControlsLabel;
+    TextLabel menuControlLabels[4];
+    TextLabel menuScoresLabel;
+    TextLabel menuScoreLabels[5];
+    TextLabel levelUpTitleLabel;
+    TextLabel levelUpLevelLabel;
+    TextLabel levelUpHintLabel;
+    std::vector<TextLabel> levelUpNumberLabels;
+    std::vector<TextLabel> levelUpNameLabels;
+    std::vector<TextLabel> levelUpDescriptionLabels;
+    int levelUpChoiceSet;       // Bumped by GenerateLevelUpChoices; the choice labels are bound to it
+    TextLabel pauseTitleLabel;
+    TextLabel pauseResumeLabel;
+    TextLabel pauseQuitLabel;
+    TextLabel gameOverTitleLabel;
+    TextLabel gameOverStatsLabel;
+    TextLabel gameOverTimeLabel;
+    TextLabel gameOverLevelLabel;
+    TextLabel gameOverKillLabel;
+    TextLabel gameOverWeaponLabel;
+    TextLabel gameOverRetryLabel;
+    TextLabel gameOverMenuLabel;
+    
     // High scores
     std::vector<HighScoreEntry> highScores;
     static const int MAX_HIGH_SCORES = 10;
     
     // Debug
     bool showDebugInfo;
+    std::vector<ProfileStat> overlayStats;      // Profiler snapshot, reused by the overlay
+    
+    // F3 text: figures are sampled and laid out DEBUG_REFRESH_RATE times a
+    // second, the layouts are drawn every frame
+    struct DebugLine {
+        TextLabel label;
+        glm::vec2 position;
+        glm::vec4 color;
+    };
+    std::vector<DebugLine> debugLines;
+    int debugLineCount;
+    long long debugRefreshTick;
+    static constexpr float DEBUG_REFRESH_RATE = 4.0f;
+    GameOptions options;
+    
+    // Metrics recording
+    MetricsRecorder metrics;
+    uint32_t lastEnemiesSpawned;
+    uint32_t lastEnemiesDied;
 };
 
 // Global game instance pointer (for GLFW callbacks)
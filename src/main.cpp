@@ -13,10 +13,113 @@
 // ============================================================================
 
 #include "game.h"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+
+static void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]" << std::endl;
+    std::cout << "  --trace [frames]     Capture a Chrome trace of the first frames (default 300)" << std::endl;
+    std::cout << "  --trace-file <path>  Output file for trace captures (default trace.json)" << std::endl;
+    std::cout << "  --headless [frames]  Run a scripted late-game simulation without a window (default 3600)" << std::endl;
+    std::cout << "  --seed <n>           Random seed for headless runs (default 1234)" << std::endl;
+    std::cout << "  --alloc-check [max] [peak]" << std::endl;
+    std::cout << "                       Headless run that fails if steady-state frames average more than" << std::endl;
+    std::cout << "                       max heap allocations (default 6), or any one makes more than peak" << std::endl;
+    std::cout << "                       (default 64)" << std::endl;
+    std::cout << "  --perf-gate [path]   Headless run compared against a perf baseline" << std::endl;
+    std::cout << "                       (default perf/baseline.json); nonzero exit on regression" << std::endl;
+    std::cout << "  --perf-update [path] Headless run recorded as the baseline for this build type and replay" << std::endl;
+    std::cout << "  --metrics <path>     Record per-frame metrics (convert with metrics2csv)" << std::endl;
+    std::cout << "  --gpu-particles      Simulate particles on the GPU (transform feedback)" << std::endl;
+    std::cout << "  --render-thread      Submit GL commands and present from a separate render thread" << std::endl;
+    std::cout << "  --offscreen [WxH]    Headless run that also renders, into a framebuffer on a windowless" << std::endl;
+    std::cout << "                       EGL context, and reports CPU and GPU frame cost (default 1280x720)" << std::endl;
+    std::cout << "  --dump-frames <dir> [every]" << std::endl;
+    std::cout << "                       Offscreen run that writes every Nth frame to dir as PNG (default 60)" << std::endl;
+    std::cout << "  --null-render        Headless run that also runs the render code, against a back end" << std::endl;
+    std::cout << "                       that drops every draw (times render submission without GL)" << std::endl;
+    std::cout << "  --record-draws [path] Headless run that records every draw in memory and reports counts;" << std::endl;
+    std::cout << "                       path gets the last frame's draws, one per line, for diffing" << std::endl;
+    std::cout << "  --help               Show this message" << std::endl;
+}
 
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
+    GameOptions options;
+    
+    // Parse command line
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--trace") {
+            options.traceAtStartup = true;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                options.traceFrames = std::max(1, std::atoi(argv[++i]));
+            }
+        } else if (arg == "--trace-file" && i + 1 < argc) {
+            options.tracePath = argv[++i];
+        } else if (arg == "--headless") {
+            options.headless = true;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                options.headlessFrames = std::max(2, std::atoi(argv[++i]));
+            }
+        } else if (arg == "--seed" && i + 1 < argc) {
+            options.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--alloc-check") {
+            options.headless = true;
+            options.allocCheck = true;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                options.allocBudget = std::atof(argv[++i]);
+                if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                    options.allocPeakBudget = std::atof(argv[++i]);
+                }
+            }
+        } else if (arg == "--metrics" && i + 1 < argc) {
+            options.metricsPath = argv[++i];
+        } else if (arg == "--gpu-particles") {
+            options.gpuParticles = true;
+        } else if (arg == "--render-thread") {
+            options.renderThread = true;
+        } else if (arg == "--offscreen") {
+            options.headless = true;
+            options.offscreen = true;
+            int width = 0, height = 0;
+            if (i + 1 < argc && std::sscanf(argv[i + 1], "%dx%d", &width, &height) == 2) {
+                options.offscreenWidth = std::max(1, width);
+                options.offscreenHeight = std::max(1, height);
+                ++i;
+            }
+        } else if (arg == "--dump-frames" && i + 1 < argc) {
+            options.headless = true;
+            options.offscreen = true;
+            options.frameDumpDir = argv[++i];
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                options.frameDumpInterval = std::max(1, std::atoi(argv[++i]));
+            }
+        } else if (arg == "--null-render") {
+            options.headless = true;
+            options.nullRender = true;
+        } else if (arg == "--record-draws") {
+            options.headless = true;
+            options.recordDraws = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                options.drawListPath = argv[++i];
+            }
+        } else if (arg == "--perf-gate" || arg == "--perf-update") {
+            options.headless = true;
+            options.perfGate = true;
+            options.perfUpdate = arg == "--perf-update";
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                options.perfBaseline = argv[++i];
+            }
+        } else if (arg == "--help" || arg == "-h") {
+            PrintUsage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            PrintUsage(argv[0]);
+            return -1;
+        }
+    }
     
     std::cout << "========================================" << std::endl;
     std::cout << "       GALAXIES AWAY" << std::endl;
@@ -27,17 +130,26 @@ int main(int argc, char* argv[]) {
     // Create and initialize game
     Game game;
     
-    if (!game.Initialize()) {
+    if (!game.Initialize(options)) {
         std::cerr << "Failed to initialize game!" << std::endl;
         return -1;
     }
     
     // Run main game loop
-    game.Run();
+    int exitCode = 0;
+    if (options.headless) {
+        exitCode = game.RunHeadless();
+    } else {
+        game.Run();
+    }
     
     // Cleanup
     game.Shutdown();
     
+    if (options.headless) {
+        return exitCode;
+    }
+    
     std::cout << std::endl;
     std::cout << "Thanks for playing Galaxies Away!" << std::endl;
     
@@ -0,0 +1,98 @@
+// ============================================================================
+// Galaxies Away - Allocation Tracking Implementation
+// ============================================================================
+
+#include "memtrack.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    // Plain counters with no constructors, safe to touch from operator new
+    // before main() and after static destruction
+    thread_local uint64_t t_allocCount = 0;
+    thread_local uint64_t t_allocBytes = 0;
+    std::atomic<uint64_t> g_allocCount(0);
+    std::atomic<uint64_t> g_allocBytes(0);
+}
+
+#ifdef ALLOC_TRACKING
+
+namespace {
+    inline void RecordAllocation(std::size_t size) {
+        t_allocCount++;
+        t_allocBytes += size;
+        g_allocCount.fetch_add(1, std::memory_order_relaxed);
+        g_allocBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    
+    void* TrackedAlloc(std::size_t size) {
+        RecordAllocation(size);
+        void* ptr = std::malloc(size ? size : 1);
+        if (!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+    
+    void* TrackedAlignedAlloc(std::size_t size, std::align_val_t align) {
+        RecordAllocation(size);
+        std::size_t alignment = static_cast<std::size_t>(align);
+        std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+        void* ptr = std::aligned_alloc(alignment, rounded ? rounded : alignment);
+        if (!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+}
+
+// ============================================================================
+// Global Operator New / Delete Replacements
+// ============================================================================
+
+void* operator new(std::size_t size) { return TrackedAlloc(size); }
+void* operator new[](std::size_t size) { return TrackedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t align) { return TrackedAlignedAlloc(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return TrackedAlignedAlloc(size, align); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    RecordAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    RecordAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+#endif // ALLOC_TRACKING
+
+// ============================================================================
+// MemTrack Implementation
+// ============================================================================
+
+namespace MemTrack {
+    bool IsEnabled() {
+#ifdef ALLOC_TRACKING
+        return true;
+#else
+        return false;
+#endif
+    }
+    
+    AllocStats GetThreadStats() {
+        return AllocStats(t_allocCount, t_allocBytes);
+    }
+    
+    AllocStats GetTotalStats() {
+        return AllocStats(g_allocCount.load(std::memory_order_relaxed), g_allocBytes.load(std::memory_order_relaxed));
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef MEMTRACK_H
+#define MEMTRACK_H
+
+// ============================================================================
+// Galaxies Away - Allocation Tracking
+// Optional global operator new instrumentation (build with -DALLOC_TRACKING)
+// ============================================================================
+
+#include <cstdint>
+
+// ============================================================================
+// Allocation Counters
+// ============================================================================
+
+struct AllocStats {
+    uint64_t count;     // Number of operator new calls
+    uint64_t bytes;     // Bytes requested
+    
+    AllocStats() : count(0), bytes(0) {}
+    AllocStats(uint64_t c, uint64_t b) : count(c), bytes(b) {}
+    
+    AllocStats operator-(const AllocStats& other) const {
+        return AllocStats(count - other.count, bytes - other.bytes);
+    }
+    AllocStats& operator+=(const AllocStats& other) {
+        count += other.count;
+        bytes += other.bytes;
+        return *this;
+    }
+};
+
+namespace MemTrack {
+    // False when the game was built without ALLOC_TRACKING; counters stay zero
+    bool IsEnabled();
+    
+    // Running totals since startup; take differences to measure a scope
+    AllocStats GetThreadStats();    // Calling thread only
+    AllocStats GetTotalStats();     // All threads
+}
+
+#endif // MEMTRACK_H
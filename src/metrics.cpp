@@ -0,0 +1,121 @@
+// ============================================================================
+// Galaxies Away - Per-Frame Metrics Recorder Implementation
+// ============================================================================
+
+#include "metrics.h"
+#include "profiler.h"
+#include <cstring>
+
+namespace {
+    // How often the writer thread wakes up to drain the queue
+    constexpr auto WRITER_INTERVAL = std::chrono::milliseconds(50);
+}
+
+// ============================================================================
+// MetricsRecorder Implementation
+// ============================================================================
+
+MetricsRecorder::MetricsRecorder()
+    : head(0)
+    , tail(0)
+    , running(false)
+    , waitWhenFull(false)
+    , dropped(0)
+    , written(0)
+{
+}
+
+MetricsRecorder::~MetricsRecorder() {
+    Stop();
+}
+
+bool MetricsRecorder::Start(const std::string& path, bool lossless) {
+    if (running) return false;
+    
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open metrics file: " << path << std::endl;
+        return false;
+    }
+    
+    MetricsFileHeader header;
+    std::memcpy(header.magic, MetricsFormat::MAGIC, sizeof(header.magic));
+    header.version = MetricsFormat::VERSION;
+    header.recordSize = sizeof(FrameRecord);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    
+    filePath = path;
+    waitWhenFull = lossless;
+    head = 0;
+    tail = 0;
+    dropped = 0;
+    written = 0;
+    running = true;
+    writer = std::thread(&MetricsRecorder::WriterLoop, this);
+    
+    std::cout << "Recording frame metrics to " << path << std::endl;
+    return true;
+}
+
+void MetricsRecorder::Stop() {
+    if (!running) return;
+    
+    running = false;
+    if (writer.joinable()) {
+        writer.join();
+    }
+    file.close();
+    
+    std::cout << "Frame metrics written to " << filePath << " (" << written << " frames";
+    if (dropped > 0) {
+        std::cout << ", " << dropped << " dropped";
+    }
+    std::cout << ")" << std::endl;
+}
+
+void MetricsRecorder::Push(const FrameRecord& record) {
+    if (!running) return;
+    
+    uint32_t h = head.load(std::memory_order_relaxed);
+    while (h - tail.load(std::memory_order_acquire) >= QUEUE_CAPACITY) {
+        if (!waitWhenFull) {
+            // Writer fell behind (slow disk); losing a record beats stalling the frame
+            dropped++;
+            return;
+        }
+        std::this_thread::yield();
+    }
+    
+    queue[h % QUEUE_CAPACITY] = record;
+    head.store(h + 1, std::memory_order_release);
+}
+
+void MetricsRecorder::WriterLoop() {
+    g_Profiler.SetThreadName("Metrics Writer");
+    
+    while (running) {
+        std::this_thread::sleep_for(WRITER_INTERVAL);
+        Drain();
+    }
+    
+    // Pick up anything pushed before Stop()
+    Drain();
+    file.flush();
+}
+
+void MetricsRecorder::Drain() {
+    PROFILE_ZONE("Write Metrics");
+    
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t h = head.load(std::memory_order_acquire);
+    written += h - t;
+    
+    // Write in at most two contiguous runs of the ring
+    while (t != h) {
+        uint32_t index = t % QUEUE_CAPACITY;
+        uint32_t run = std::min(h - t, QUEUE_CAPACITY - index);
+        file.write(reinterpret_cast<const char*>(&queue[index]), run * sizeof(FrameRecord));
+        t += run;
+        tail.store(t, std::memory_order_release);
+    }
+}
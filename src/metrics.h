@@ -0,0 +1,98 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+// ============================================================================
+// Galaxies Away - Per-Frame Metrics Recorder
+// Streams one compact binary record per frame to disk from a background
+// thread. Convert recordings with tools/metrics2csv.
+// ============================================================================
+
+#include <cstdint>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <atomic>
+
+// ============================================================================
+// File Format
+// A MetricsFileHeader followed by tightly packed FrameRecords (little endian)
+// ============================================================================
+
+namespace MetricsFormat {
+    constexpr char MAGIC[8] = {'G', 'A', 'M', 'E', 'T', 'R', 'C', '1'};
+    constexpr uint32_t VERSION = 2;     // 2: renderer state-change counters
+}
+
+struct MetricsFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;    // sizeof(FrameRecord), lets readers skip fields they don't know
+};
+
+struct FrameRecord {
+    uint32_t frame;
+    float gameTime;         // Simulation time survived, seconds
+    float frameMs;          // Whole frame, CPU
+    float updateMs;         // Simulation
+    float renderMs;         // Render submission
+    uint32_t drawCalls;
+    uint32_t bytesUploaded;
+    uint16_t enemies;
+    uint16_t projectiles;
+    uint16_t orbs;
+    uint16_t particles;
+    uint16_t spawns;        // Enemies spawned this frame
+    uint16_t deaths;        // Enemies killed this frame
+    
+    // Version 2; new fields only ever go at the end
+    uint32_t programSwitches;
+    uint32_t textureBinds;
+    uint32_t uniformUploads;
+    uint32_t bufferUploads;
+    uint32_t vertices;
+};
+
+static_assert(sizeof(MetricsFileHeader) == 16, "Metrics header layout changed");
+static_assert(sizeof(FrameRecord) == 60, "Frame record layout changed; bump MetricsFormat::VERSION");
+
+// ============================================================================
+// Metrics Recorder
+// ============================================================================
+
+class MetricsRecorder {
+public:
+    static const uint32_t QUEUE_CAPACITY = 1024;    // Frames buffered before records are dropped
+    
+    MetricsRecorder();
+    ~MetricsRecorder();
+    
+    // lossless makes Push wait for the writer instead of dropping records;
+    // meant for headless runs, which have no frame deadline to miss
+    bool Start(const std::string& path, bool lossless = false);
+    void Stop();            // Flushes queued records and joins the writer thread
+    bool IsRecording() const { return running; }
+    
+    // Called once per frame by the game loop; never blocks unless lossless
+    void Push(const FrameRecord& record);
+    
+    uint64_t GetDroppedCount() const { return dropped; }
+
+private:
+    void WriterLoop();
+    void Drain();
+    
+    // Single-producer, single-consumer ring buffer
+    FrameRecord queue[QUEUE_CAPACITY];
+    std::atomic<uint32_t> head;     // Next slot the game writes
+    std::atomic<uint32_t> tail;     // Next slot the writer reads
+    
+    std::atomic<bool> running;
+    bool waitWhenFull;
+    std::atomic<uint64_t> dropped;
+    uint64_t written;
+    std::thread writer;
+    std::ofstream file;
+    std::string filePath;
+};
+
+#endif // METRICS_H
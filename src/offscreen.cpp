@@ -0,0 +1,288 @@
+// ============================================================================
+// Galaxies Away - Offscreen Rendering Implementation
+// ============================================================================
+
+#include "offscreen.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef __linux__
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+namespace {
+    // ========================================================================
+    // Minimal PNG writer: stored (uncompressed) deflate blocks, so no zlib.
+    // Files are large, but byte-exact and trivial to diff against goldens.
+    // ========================================================================
+    
+    uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc) {
+        static uint32_t table[256];
+        static bool tableReady = false;
+        if (!tableReady) {
+            for (uint32_t n = 0; n < 256; ++n) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                table[n] = c;
+            }
+            tableReady = true;
+        }
+        
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i) {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+    
+    void PutBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+    
+    void WriteChunk(std::ofstream& file, const char* type, const std::vector<uint8_t>& data) {
+        std::vector<uint8_t> chunk;
+        chunk.reserve(data.size() + 12);
+        PutBigEndian(chunk, static_cast<uint32_t>(data.size()));
+        chunk.insert(chunk.end(), type, type + 4);
+        chunk.insert(chunk.end(), data.begin(), data.end());
+        PutBigEndian(chunk, Crc32(chunk.data() + 4, chunk.size() - 4, 0));
+        file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+    }
+    
+    // rgb is top row first, width * 3 bytes per row
+    bool WritePng(const std::string& path, int width, int height, const uint8_t* rgb) {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        
+        const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+        
+        std::vector<uint8_t> header;
+        PutBigEndian(header, static_cast<uint32_t>(width));
+        PutBigEndian(header, static_cast<uint32_t>(height));
+        header.push_back(8);    // Bit depth
+        header.push_back(2);    // Truecolor
+        header.push_back(0);    // Deflate
+        header.push_back(0);    // Adaptive filtering
+        header.push_back(0);    // Not interlaced
+        WriteChunk(file, "IHDR", header);
+        
+        // Every row starts with filter type 0 (none)
+        const size_t rowBytes = static_cast<size_t>(width) * 3;
+        std::vector<uint8_t> raw;
+        raw.reserve((rowBytes + 1) * height);
+        for (int y = 0; y < height; ++y) {
+            raw.push_back(0);
+            raw.insert(raw.end(), rgb + y * rowBytes, rgb + (y + 1) * rowBytes);
+        }
+        
+        // zlib stream of stored blocks (at most 65535 bytes each) and an Adler-32
+        std::vector<uint8_t> zlib;
+        zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+        zlib.push_back(0x78);
+        zlib.push_back(0x01);
+        size_t offset = 0;
+        do {
+            size_t blockSize = std::min<size_t>(raw.size() - offset, 65535);
+            bool last = offset + blockSize == raw.size();
+            zlib.push_back(last ? 1 : 0);
+            zlib.push_back(static_cast<uint8_t>(blockSize));
+            zlib.push_back(static_cast<uint8_t>(blockSize >> 8));
+            zlib.push_back(static_cast<uint8_t>(~blockSize));
+            zlib.push_back(static_cast<uint8_t>(~blockSize >> 8));
+            zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+            offset += blockSize;
+        } while (offset < raw.size());
+        
+        uint32_t a = 1, b = 0;
+        for (uint8_t byte : raw) {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        PutBigEndian(zlib, (b << 16) | a);
+        WriteChunk(file, "IDAT", zlib);
+        
+        WriteChunk(file, "IEND", std::vector<uint8_t>());
+        return file.good();
+    }
+}
+
+// ============================================================================
+// Offscreen Target Implementation
+// ============================================================================
+
+OffscreenTarget::OffscreenTarget()
+    : display(nullptr)
+    , context(nullptr)
+    , width(0), height(0)
+    , framebuffer(0)
+    , colorBuffer(0)
+{
+}
+
+OffscreenTarget::~OffscreenTarget() {
+    Shutdown();
+}
+
+bool OffscreenTarget::Initialize(int targetWidth, int targetHeight) {
+    width = targetWidth;
+    height = targetHeight;
+    
+    if (!CreateContext()) {
+        return false;
+    }
+    
+    // The renderer never binds framebuffers itself, so binding this one once
+    // sends everything it draws here
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Offscreen framebuffer is incomplete" << std::endl;
+        Shutdown();
+        return false;
+    }
+    
+    std::cout << "Rendering offscreen at " << width << "x" << height << std::endl;
+    return true;
+}
+
+void OffscreenTarget::Shutdown() {
+    if (!context) return;
+    
+    if (framebuffer) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteFramebuffers(1, &framebuffer);
+        framebuffer = 0;
+    }
+    if (colorBuffer) {
+        glDeleteRenderbuffers(1, &colorBuffer);
+        colorBuffer = 0;
+    }
+    DestroyContext();
+}
+
+bool OffscreenTarget::SavePng(const std::string& path) {
+    if (!framebuffer) return false;
+    
+    // GL rows run bottom-up; PNG rows run top-down
+    const size_t rowBytes = static_cast<size_t>(width) * 3;
+    pixels.resize(rowBytes * height * 2);
+    uint8_t* readBack = pixels.data();
+    uint8_t* flipped = pixels.data() + rowBytes * height;
+    
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, readBack);
+    for (int y = 0; y < height; ++y) {
+        std::memcpy(flipped + y * rowBytes, readBack + (height - 1 - y) * rowBytes, rowBytes);
+    }
+    
+    if (!WritePng(path, width, height, flipped)) {
+        std::cerr << "Failed to write frame: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#ifdef __linux__
+
+bool OffscreenTarget::CreateContext() {
+    // The surfaceless platform needs no display server; fall back to the default display
+    EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay) {
+        eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (eglDisplay == EGL_NO_DISPLAY) {
+        eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    
+    EGLint major = 0, minor = 0;
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, &major, &minor)) {
+        std::cerr << "Failed to initialize EGL" << std::endl;
+        return false;
+    }
+    display = eglDisplay;
+    
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "EGL has no desktop OpenGL support" << std::endl;
+        DestroyContext();
+        return false;
+    }
+    
+    // Any config will do: nothing is drawn to an EGL surface
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(eglDisplay, configAttribs, &config, 1, &configCount) || configCount == 0) {
+        config = nullptr; // EGL_KHR_no_config_context
+    }
+    
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttribs);
+    if (eglContext == EGL_NO_CONTEXT) {
+        std::cerr << "Failed to create an OpenGL 3.3 core context (EGL error 0x" << std::hex
+                  << eglGetError() << std::dec << ")" << std::endl;
+        DestroyContext();
+        return false;
+    }
+    context = eglContext;
+    
+    // Surfaceless: the framebuffer object is the only render target
+    if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext)) {
+        std::cerr << "Failed to make the offscreen context current" << std::endl;
+        DestroyContext();
+        return false;
+    }
+    
+    std::cout << "EGL " << major << "." << minor << " offscreen context" << std::endl;
+    return true;
+}
+
+void OffscreenTarget::DestroyContext() {
+    if (display) {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context) {
+            eglDestroyContext(display, context);
+        }
+        eglTerminate(display);
+    }
+    display = nullptr;
+    context = nullptr;
+}
+
+#else
+
+bool OffscreenTarget::CreateContext() {
+    std::cerr << "Offscreen rendering needs EGL (Linux only)" << std::endl;
+    return false;
+}
+
+void OffscreenTarget::DestroyContext() {
+    display = nullptr;
+    context = nullptr;
+}
+
+#endif
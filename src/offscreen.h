@@ -0,0 +1,48 @@
+#ifndef OFFSCREEN_H
+#define OFFSCREEN_H
+
+// ============================================================================
+// Galaxies Away - Offscreen Rendering
+// A windowless GL 3.3 core context (EGL, surfaceless platform) rendering into
+// a framebuffer object, for benchmarks and golden images on machines with no
+// display or GPU (Mesa's llvmpipe will do)
+// ============================================================================
+
+#include "renderer.h"
+
+// ============================================================================
+// Offscreen Target
+// ============================================================================
+
+class OffscreenTarget {
+public:
+    OffscreenTarget();
+    ~OffscreenTarget();
+    
+    // Creates the context, makes it current and binds a width x height
+    // framebuffer in place of the default one
+    bool Initialize(int width, int height);
+    void Shutdown();
+    bool IsInitialized() const { return context != nullptr; }
+    
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+    
+    // Reads back the last rendered frame (waits for the GPU) and writes it as an RGB PNG
+    bool SavePng(const std::string& path);
+
+private:
+    bool CreateContext();
+    void DestroyContext();
+    
+    // EGL handles, kept opaque so EGL headers stay out of the rest of the game
+    void* display;
+    void* context;
+    
+    int width, height;
+    GLuint framebuffer;
+    GLuint colorBuffer;
+    std::vector<uint8_t> pixels;    // Read-back scratch, reused between dumps
+};
+
+#endif // OFFSCREEN_H
@@ -0,0 +1,381 @@
+// ============================================================================
+// Galaxies Away - Performance Regression Gate Implementation
+// ============================================================================
+
+#include "perf.h"
+#include "memtrack.h"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    const int BASELINE_VERSION = 2;     // 2: metrics keyed on build type, then replay
+    
+    // ========================================================================
+    // Minimal JSON reader/writer (just enough for the baseline file)
+    // ========================================================================
+    
+    struct JsonValue {
+        enum class Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+        
+        Type type;
+        bool boolean;
+        double number;
+        std::string text;
+        std::vector<JsonValue> items;
+        std::vector<std::pair<std::string, JsonValue>> members;  // Keeps file order
+        
+        JsonValue() : type(Type::NUL), boolean(false), number(0.0) {}
+        
+        static JsonValue Number(double value) {
+            JsonValue v;
+            v.type = Type::NUMBER;
+            v.number = value;
+            return v;
+        }
+        
+        static JsonValue String(const std::string& value) {
+            JsonValue v;
+            v.type = Type::STRING;
+            v.text = value;
+            return v;
+        }
+        
+        static JsonValue Object() {
+            JsonValue v;
+            v.type = Type::OBJECT;
+            return v;
+        }
+        
+        const JsonValue* Find(const std::string& key) const {
+            for (const auto& member : members) {
+                if (member.first == key) return &member.second;
+            }
+            return nullptr;
+        }
+        
+        void Set(const std::string& key, const JsonValue& value) {
+            for (auto& member : members) {
+                if (member.first == key) {
+                    member.second = value;
+                    return;
+                }
+            }
+            members.emplace_back(key, value);
+        }
+        
+        double GetNumber(const std::string& key, double fallback) const {
+            const JsonValue* v = Find(key);
+            return v && v->type == Type::NUMBER ? v->number : fallback;
+        }
+    };
+    
+    class JsonParser {
+    public:
+        explicit JsonParser(const std::string& source) : src(source), pos(0) {}
+        
+        bool Parse(JsonValue& out) {
+            if (!ParseValue(out)) return false;
+            SkipWhitespace();
+            return pos == src.size();
+        }
+    
+    private:
+        void SkipWhitespace() {
+            while (pos < src.size() && std::isspace(static_cast<unsigned char>(src[pos]))) pos++;
+        }
+        
+        bool Consume(char c) {
+            SkipWhitespace();
+            if (pos < src.size() && src[pos] == c) {
+                pos++;
+                return true;
+            }
+            return false;
+        }
+        
+        bool ParseLiteral(const char* word) {
+            size_t len = std::strlen(word);
+            if (src.compare(pos, len, word) != 0) return false;
+            pos += len;
+            return true;
+        }
+        
+        bool ParseString(std::string& out) {
+            if (!Consume('"')) return false;
+            out.clear();
+            while (pos < src.size() && src[pos] != '"') {
+                char c = src[pos++];
+                if (c == '\\' && pos < src.size()) {
+                    char e = src[pos++];
+                    switch (e) {
+                        case 'n': out += '\n'; break;
+                        case 't': out += '\t'; break;
+                        case 'u': pos += 4; out += '?'; break;  // Not needed for metric names
+                        default:  out += e; break;
+                    }
+                } else {
+                    out += c;
+                }
+            }
+            return pos++ < src.size();
+        }
+        
+        bool ParseValue(JsonValue& out) {
+            SkipWhitespace();
+            if (pos >= src.size()) return false;
+            
+            char c = src[pos];
+            if (c == '{') {
+                pos++;
+                out = JsonValue::Object();
+                if (Consume('}')) return true;
+                do {
+                    std::string key;
+                    JsonValue value;
+                    if (!ParseString(key) || !Consume(':') || !ParseValue(value)) return false;
+                    out.members.emplace_back(key, value);
+                } while (Consume(','));
+                return Consume('}');
+            }
+            if (c == '[') {
+                pos++;
+                out.type = JsonValue::Type::ARRAY;
+                if (Consume(']')) return true;
+                do {
+                    JsonValue value;
+                    if (!ParseValue(value)) return false;
+                    out.items.push_back(value);
+                } while (Consume(','));
+                return Consume(']');
+            }
+            if (c == '"') {
+                out.type = JsonValue::Type::STRING;
+                return ParseString(out.text);
+            }
+            if (ParseLiteral("true")) {
+                out.type = JsonValue::Type::BOOLEAN;
+                out.boolean = true;
+                return true;
+            }
+            if (ParseLiteral("false")) {
+                out.type = JsonValue::Type::BOOLEAN;
+                out.boolean = false;
+                return true;
+            }
+            if (ParseLiteral("null")) {
+                out.type = JsonValue::Type::NUL;
+                return true;
+            }
+            
+            const char* start = src.c_str() + pos;
+            char* end = nullptr;
+            out.number = std::strtod(start, &end);
+            if (end == start) return false;
+            out.type = JsonValue::Type::NUMBER;
+            pos += end - start;
+            return true;
+        }
+        
+        const std::string& src;
+        size_t pos;
+    };
+    
+    void WriteJson(std::ostream& out, const JsonValue& value, int indent) {
+        std::string pad(indent * 2, ' ');
+        switch (value.type) {
+            case JsonValue::Type::NUL:     out << "null"; break;
+            case JsonValue::Type::BOOLEAN: out << (value.boolean ? "true" : "false"); break;
+            case JsonValue::Type::NUMBER: {
+                char buffer[32];
+                std::snprintf(buffer, sizeof(buffer), "%.6g", value.number);
+                out << buffer;
+                break;
+            }
+            case JsonValue::Type::STRING:  out << '"' << value.text << '"'; break;
+            case JsonValue::Type::ARRAY:
+                out << "[";
+                for (size_t i = 0; i < value.items.size(); ++i) {
+                    out << (i ? ", " : "");
+                    WriteJson(out, value.items[i], indent);
+                }
+                out << "]";
+                break;
+            case JsonValue::Type::OBJECT: {
+                // Metric entries are short; keep each on one line
+                bool flat = true;
+                for (const auto& member : value.members) {
+                    if (member.second.type == JsonValue::Type::OBJECT) flat = false;
+                }
+                if (flat) {
+                    out << "{ ";
+                    for (size_t i = 0; i < value.members.size(); ++i) {
+                        out << (i ? ", " : "") << '"' << value.members[i].first << "\": ";
+                        WriteJson(out, value.members[i].second, indent);
+                    }
+                    out << (value.members.empty() ? "}" : " }");
+                    break;
+                }
+                out << "{\n";
+                for (size_t i = 0; i < value.members.size(); ++i) {
+                    out << pad << "  \"" << value.members[i].first << "\": ";
+                    WriteJson(out, value.members[i].second, indent + 1);
+                    out << (i + 1 < value.members.size() ? ",\n" : "\n");
+                }
+                out << pad << "}";
+                break;
+            }
+        }
+    }
+    
+    bool LoadJson(const std::string& path, JsonValue& out) {
+        std::ifstream file(path);
+        if (!file.is_open()) return false;
+        
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        std::string source = buffer.str();
+        JsonParser parser(source);
+        return parser.Parse(out) && out.type == JsonValue::Type::OBJECT;
+    }
+}
+
+// ============================================================================
+// Perf Gate Implementation
+// ============================================================================
+
+namespace Perf {
+    const char* GetBuildType() {
+        // Counting allocations slows every operator new, so tracked builds
+        // keep timings of their own
+        bool tracked = MemTrack::IsEnabled();
+#if defined(DEBUG)
+        return tracked ? "debug+alloc-tracking" : "debug";
+#elif defined(__OPTIMIZE__) || defined(NDEBUG)
+        return tracked ? "release+alloc-tracking" : "release";
+#else
+        return tracked ? "unoptimized+alloc-tracking" : "unoptimized";
+#endif
+    }
+    
+    int RunGate(const std::string& baselinePath, const std::string& replay,
+                const std::vector<PerfMetric>& metrics, std::ostream& out) {
+        const char* buildType = GetBuildType();
+        
+        JsonValue root;
+        if (!LoadJson(baselinePath, root)) {
+            std::cerr << "Failed to read perf baseline: " << baselinePath << std::endl;
+            return 2;
+        }
+        if (root.GetNumber("version", 0.0) != BASELINE_VERSION) {
+            std::cerr << "Perf baseline " << baselinePath << " has an older layout; re-record it with --perf-update"
+                      << std::endl;
+            return 2;
+        }
+        const JsonValue* section = root.Find(buildType);
+        const JsonValue* baseline = section ? section->Find(replay) : nullptr;
+        if (!baseline || baseline->type != JsonValue::Type::OBJECT) {
+            std::cerr << "No '" << buildType << "' baseline for replay '" << replay << "' in " << baselinePath
+                      << "; record one with --perf-update" << std::endl;
+            return 2;
+        }
+        
+        char line[160];
+        int regressions = 0;
+        out << "Perf gate [" << buildType << "] " << replay << " against " << baselinePath << std::endl;
+        std::snprintf(line, sizeof(line), "  %-24s %12s %12s %9s %12s  %s",
+                      "Metric", "Baseline", "Current", "Change", "Limit", "Status");
+        out << line << std::endl;
+        
+        for (const PerfMetric& metric : metrics) {
+            const JsonValue* entry = baseline->Find(metric.name);
+            if (!entry) {
+                std::snprintf(line, sizeof(line), "  %-24s %12s %12.4f %9s %12s  new",
+                              metric.name.c_str(), "-", metric.value, "-", "-");
+                out << line << std::endl;
+                continue;
+            }
+            
+            // Tolerances in the baseline file win, so they can be tuned by hand
+            double base = entry->GetNumber("value", 0.0);
+            double tolerance = entry->GetNumber("tolerance", metric.tolerance);
+            double slack = entry->GetNumber("slack", metric.slack);
+            double limit = base * (1.0 + tolerance) + slack;
+            double change = base != 0.0 ? (metric.value - base) / base * 100.0 : 0.0;
+            
+            const char* status = "ok";
+            if (metric.value > limit) {
+                status = "REGRESSED";
+                regressions++;
+            } else if (metric.value < base * (1.0 - tolerance) - slack) {
+                status = "improved";
+            }
+            
+            std::snprintf(line, sizeof(line), "  %-24s %12.4f %12.4f %+8.1f%% %12.4f  %s",
+                          metric.name.c_str(), base, metric.value, change, limit, status);
+            out << line << std::endl;
+        }
+        
+        for (const auto& member : baseline->members) {
+            bool found = false;
+            for (const PerfMetric& metric : metrics) {
+                if (metric.name == member.first) found = true;
+            }
+            if (!found) {
+                std::snprintf(line, sizeof(line), "  %-24s %12.4f %12s %9s %12s  missing",
+                              member.first.c_str(), member.second.GetNumber("value", 0.0), "-", "-", "-");
+                out << line << std::endl;
+            }
+        }
+        
+        if (regressions > 0) {
+            out << "Perf gate FAILED: " << regressions << " metric(s) regressed" << std::endl;
+            return 1;
+        }
+        out << "Perf gate PASSED" << std::endl;
+        return 0;
+    }
+    
+    bool WriteBaseline(const std::string& baselinePath, const std::string& replay,
+                       const std::vector<PerfMetric>& metrics) {
+        const char* buildType = GetBuildType();
+        
+        // A file in an older layout is started over rather than misread
+        JsonValue root;
+        if (!LoadJson(baselinePath, root) || root.GetNumber("version", 0.0) != BASELINE_VERSION) {
+            root = JsonValue::Object();
+        }
+        root.Set("version", JsonValue::Number(BASELINE_VERSION));
+        
+        JsonValue section = JsonValue::Object();
+        if (const JsonValue* oldSection = root.Find(buildType)) {
+            section = *oldSection;
+        }
+        const JsonValue* oldMetrics = section.Find(replay);
+        
+        JsonValue metricsObject = JsonValue::Object();
+        for (const PerfMetric& metric : metrics) {
+            const JsonValue* old = oldMetrics ? oldMetrics->Find(metric.name) : nullptr;
+            JsonValue entry = JsonValue::Object();
+            entry.Set("value", JsonValue::Number(metric.value));
+            entry.Set("tolerance", JsonValue::Number(old ? old->GetNumber("tolerance", metric.tolerance) : metric.tolerance));
+            entry.Set("slack", JsonValue::Number(old ? old->GetNumber("slack", metric.slack) : metric.slack));
+            metricsObject.Set(metric.name, entry);
+        }
+        
+        section.Set(replay, metricsObject);
+        root.Set(buildType, section);
+        
+        std::ofstream file(baselinePath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to write perf baseline: " << baselinePath << std::endl;
+            return false;
+        }
+        WriteJson(file, root, 0);
+        file << "\n";
+        
+        std::cout << "Perf baseline [" << buildType << "] " << replay << " written to " << baselinePath << std::endl;
+        return true;
+    }
+}
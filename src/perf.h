@@ -0,0 +1,48 @@
+#ifndef PERF_H
+#define PERF_H
+
+// ============================================================================
+// Galaxies Away - Performance Regression Gate
+// Compares headless run metrics against a checked-in baseline JSON file
+// ============================================================================
+
+#include "utils.h"
+
+// ============================================================================
+// Performance Metric
+// ============================================================================
+
+struct PerfMetric {
+    std::string name;
+    double value;
+    double tolerance;   // Allowed relative increase (0.25 = 25% slower)
+    double slack;       // Allowed absolute increase, keeps tiny values from flapping
+    
+    PerfMetric() : value(0.0), tolerance(0.0), slack(0.0) {}
+    PerfMetric(const std::string& n, double v, double tol, double s)
+        : name(n), value(v), tolerance(tol), slack(s) {}
+};
+
+// ============================================================================
+// Perf Gate
+// ============================================================================
+
+namespace Perf {
+    // Build flavour the baseline is keyed on ("debug", "release" or
+    // "unoptimized", with "+alloc-tracking" when allocations are counted)
+    const char* GetBuildType();
+    
+    // Compare metrics against the baseline for this build type and replay
+    // (the description of the headless run) and print a table. Returns 0 when
+    // within tolerance, 1 on regression, 2 when the file is unreadable or has
+    // no entry for this build type and replay.
+    int RunGate(const std::string& baselinePath, const std::string& replay,
+                const std::vector<PerfMetric>& metrics, std::ostream& out);
+    
+    // Store metrics as the new baseline for this build type and replay, keeping
+    // the entries of other build types and replays and any hand-tuned tolerances
+    bool WriteBaseline(const std::string& baselinePath, const std::string& replay,
+                       const std::vector<PerfMetric>& metrics);
+}
+
+#endif // PERF_H
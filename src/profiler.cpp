@@ -0,0 +1,359 @@
+// ============================================================================
+// Galaxies Away - Frame Profiler Implementation
+// ============================================================================
+
+#include "profiler.h"
+#include <iomanip>
+#include <cstring>
+
+// Global profiler instance
+Profiler g_Profiler;
+
+namespace {
+    // Smoothing factor for the overlay averages
+    constexpr double AVERAGE_WEIGHT = 0.05;
+    
+    // GPU results trail the CPU by a couple of frames; keep listening this long
+    constexpr int CAPTURE_DRAIN_FRAMES = 4;
+    
+    // Track id used for GPU pass events in trace captures
+    constexpr int GPU_THREAD_ID = 1000;
+    
+    // Trace event cap so a forgotten capture can't eat all memory
+    constexpr size_t MAX_TRACE_EVENTS = 1000000;
+    
+    struct ThreadZone {
+        const char* name;
+        double start;
+        AllocStats startAllocs;
+        AllocStats childAllocs;     // Made by nested zones, excluded from this one
+    };
+    
+    // Each thread keeps its own stack of open zones
+    thread_local std::vector<ThreadZone> t_zoneStack;
+    thread_local int t_threadId = -1;
+    
+    void WriteJsonString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            } else if (static_cast<unsigned char>(c) >= 0x20) {
+                out << c;
+            }
+        }
+        out << '"';
+    }
+}
+
+// ============================================================================
+// Profiler Implementation
+// ============================================================================
+
+Profiler::Profiler()
+    : epoch(std::chrono::steady_clock::now())
+    , frameIndex(0)
+    , frameStart(0.0)
+    , frameStat("Frame")
+    , zoneLimitWarned(false)
+    , captureState(CaptureState::IDLE)
+    , captureFramesLeft(0)
+    , captureStart(0.0)
+    , captureEnd(0.0)
+    , nextThreadId(1)
+{
+    cpuStats.reserve(MAX_ZONES);
+    gpuStats.reserve(MAX_ZONES);
+    frameSamples.reserve(MAX_ZONES);
+}
+
+double Profiler::Now() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::BeginFrame() {
+    frameStart = Now();
+    // The frame is charged with the game thread's allocations only, like the
+    // zones; the render thread and metrics writer allocate on their own time
+    frameStartAllocs = MemTrack::GetThreadStats();
+    
+    if (captureState == CaptureState::PENDING) {
+        std::lock_guard<std::mutex> lock(mutex);
+        traceEvents.clear();
+        captureStart = frameStart;
+        captureState = CaptureState::RECORDING;
+    }
+}
+
+void Profiler::EndFrame() {
+    double frameEnd = Now();
+    ZoneSample frame((frameEnd - frameStart) * 1000.0, MemTrack::GetThreadStats() - frameStartAllocs);
+    bool writeCapture = false;
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        AccumulateStat(frameStat, frame);
+        for (size_t i = 0; i < cpuStats.size(); ++i) {
+            AccumulateStat(cpuStats[i], frameSamples[i]);
+            frameSamples[i] = ZoneSample();
+        }
+        frameIndex++;
+        
+        if (captureState == CaptureState::RECORDING) {
+            traceEvents.push_back({frameStat.name, "frame", GetThreadId(), frameStart, frameEnd - frameStart, frame.allocs.count});
+            if (--captureFramesLeft <= 0) {
+                captureEnd = frameEnd;
+                captureFramesLeft = CAPTURE_DRAIN_FRAMES;
+                captureState = CaptureState::DRAINING;
+            }
+        } else if (captureState == CaptureState::DRAINING) {
+            writeCapture = --captureFramesLeft <= 0;
+        }
+    }
+    
+    if (writeCapture) {
+        WriteCapture();
+    }
+}
+
+void Profiler::BeginZone(const char* name) {
+    // Reserve up front so the zone stack itself never shows up as an allocation
+    if (t_zoneStack.capacity() == 0) {
+        t_zoneStack.reserve(32);
+    }
+    t_zoneStack.push_back({name, Now(), MemTrack::GetThreadStats(), AllocStats()});
+}
+
+void Profiler::EndZone() {
+    if (t_zoneStack.empty()) return;
+    
+    ThreadZone zone = t_zoneStack.back();
+    t_zoneStack.pop_back();
+    double ms = (Now() - zone.start) * 1000.0;
+    AllocStats inclusive = MemTrack::GetThreadStats() - zone.startAllocs;
+    if (!t_zoneStack.empty()) {
+        t_zoneStack.back().childAllocs += inclusive;
+    }
+    AllocStats exclusive = inclusive - zone.childAllocs;
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ProfileStat* stat = FindStat(cpuStats, zone.name)) {
+        ZoneSample& sample = frameSamples[stat - cpuStats.data()];
+        sample.ms += ms;
+        sample.allocs += exclusive;
+    }
+    
+    if (captureState == CaptureState::RECORDING && traceEvents.size() < MAX_TRACE_EVENTS) {
+        traceEvents.push_back({zone.name, "cpu", GetThreadId(), zone.start, ms / 1000.0, exclusive.count});
+    }
+}
+
+void Profiler::ReportGpuTime(const char* name, double ms) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ProfileStat* stat = FindStat(gpuStats, name)) {
+        AccumulateStat(*stat, ZoneSample(ms, AllocStats()));
+    }
+}
+
+void Profiler::RecordGpuEvent(const char* name, double start, double ms) {
+    if (captureState != CaptureState::RECORDING && captureState != CaptureState::DRAINING) return;
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    if (start < captureStart || (captureState == CaptureState::DRAINING && start > captureEnd)) return;
+    if (traceEvents.size() < MAX_TRACE_EVENTS) {
+        traceEvents.push_back({name, "gpu", GPU_THREAD_ID, start, ms / 1000.0, 0});
+    }
+}
+
+void Profiler::Mark(const char* name) {
+    if (captureState != CaptureState::RECORDING) return;
+    
+    double now = Now();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (traceEvents.size() < MAX_TRACE_EVENTS) {
+        traceEvents.push_back({name, "marker", GetThreadId(), now, -1.0, 0});
+    }
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int id = GetThreadId();
+    for (auto& entry : threadNames) {
+        if (entry.first == id) {
+            entry.second = name;
+            return;
+        }
+    }
+    threadNames.emplace_back(id, name);
+}
+
+void Profiler::StartCapture(int frameCount, const std::string& path) {
+    if (frameCount <= 0 || captureState != CaptureState::IDLE) return;
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    captureFramesLeft = frameCount;
+    capturePath = path;
+    captureEnd = 0.0;
+    captureState = CaptureState::PENDING;
+    std::cout << "Capturing " << frameCount << " frames to " << path << std::endl;
+}
+
+void Profiler::StopCapture() {
+    if (captureState == CaptureState::RECORDING || captureState == CaptureState::DRAINING) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (captureEnd == 0.0) captureEnd = Now();
+        }
+        WriteCapture();
+    }
+    captureState = CaptureState::IDLE;
+}
+
+int Profiler::GetThreadId() {
+    // Called with the mutex held
+    if (t_threadId < 0) {
+        t_threadId = nextThreadId++;
+    }
+    return t_threadId;
+}
+
+void Profiler::WriteCapture() {
+    std::vector<TraceEvent> events;
+    std::vector<std::pair<int, std::string>> names;
+    std::string path;
+    double origin;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.swap(traceEvents);
+        names = threadNames;
+        path = capturePath;
+        origin = captureStart;
+        captureState = CaptureState::IDLE;
+    }
+    
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write trace capture: " << path << std::endl;
+        return;
+    }
+    
+    // Chrome trace-event format, timestamps in microseconds
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"" << Constants::WINDOW_TITLE << "\"}}";
+    for (const auto& entry : names) {
+        file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << entry.first << ",\"args\":{\"name\":";
+        WriteJsonString(file, entry.second);
+        file << "}}";
+    }
+    file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GPU_THREAD_ID << ",\"args\":{\"name\":\"GPU\"}}";
+    
+    for (const auto& event : events) {
+        file << ",\n{\"name\":";
+        WriteJsonString(file, event.name);
+        file << ",\"cat\":\"" << event.category << "\",\"pid\":1,\"tid\":" << event.threadId
+             << ",\"ts\":" << (event.start - origin) * 1.0e6;
+        if (event.duration < 0.0) {
+            file << ",\"ph\":\"i\",\"s\":\"t\"}";
+        } else {
+            file << ",\"ph\":\"X\",\"dur\":" << event.duration * 1.0e6;
+            if (event.allocs > 0) {
+                file << ",\"args\":{\"allocs\":" << event.allocs << "}";
+            }
+            file << "}";
+        }
+    }
+    file << "\n]}\n";
+    
+    std::cout << "Trace capture written to " << path << " (" << events.size() << " events)" << std::endl;
+}
+
+void Profiler::GetCpuStats(std::vector<ProfileStat>& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    out.assign(cpuStats.begin(), cpuStats.end());
+}
+
+void Profiler::GetGpuStats(std::vector<ProfileStat>& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    out.assign(gpuStats.begin(), gpuStats.end());
+}
+
+double Profiler::GetZoneMs(const char* name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& stat : cpuStats) {
+        if (std::strcmp(stat.name, name) == 0) return stat.lastMs;
+    }
+    return 0.0;
+}
+
+ProfileStat* Profiler::FindStat(std::vector<ProfileStat>& stats, const char* name) {
+    // Compared by content: identical literals in different translation units
+    // need not share an address
+    for (auto& stat : stats) {
+        if (stat.name == name || std::strcmp(stat.name, name) == 0) return &stat;
+    }
+    if (stats.size() >= static_cast<size_t>(MAX_ZONES)) {
+        if (!zoneLimitWarned) {
+            std::cerr << "Profiler: more than " << MAX_ZONES << " zones, ignoring " << name << std::endl;
+            zoneLimitWarned = true;
+        }
+        return nullptr;
+    }
+    stats.emplace_back(name);
+    if (&stats == &cpuStats) {
+        frameSamples.emplace_back();
+    }
+    return &stats.back();
+}
+
+void Profiler::AccumulateStat(ProfileStat& stat, const ZoneSample& sample) {
+    double ms = sample.ms;
+    stat.lastMs = ms;
+    stat.avgMs = stat.frames == 0 ? ms : stat.avgMs + (ms - stat.avgMs) * AVERAGE_WEIGHT;
+    stat.totalMs += ms;
+    stat.maxMs = std::max(stat.maxMs, ms);
+    stat.lastAllocs = sample.allocs;
+    stat.totalAllocs += sample.allocs;
+    stat.maxAllocs = std::max(stat.maxAllocs, sample.allocs.count);
+    stat.frames++;
+}
+
+void Profiler::PrintSummary(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (frameStat.frames == 0) return;
+    
+    bool showAllocs = MemTrack::IsEnabled();
+    auto printStat = [&out, showAllocs](const char* prefix, const ProfileStat& stat) {
+        double avg = stat.frames > 0 ? stat.totalMs / stat.frames : 0.0;
+        out << "  " << prefix << std::left << std::setw(16) << stat.name << std::right
+            << " avg " << std::setw(7) << avg << " ms   max " << std::setw(7) << stat.maxMs << " ms";
+        if (showAllocs && prefix[0] == 'C') {
+            double allocs = stat.frames > 0 ? static_cast<double>(stat.totalAllocs.count) / stat.frames : 0.0;
+            out << "   allocs/frame " << std::setw(8) << allocs << "   max " << stat.maxAllocs;
+        }
+        out << std::endl;
+    };
+    
+    out << std::fixed << std::setprecision(3);
+    out << "Profiler summary (" << frameStat.frames << " frames)" << std::endl;
+    printStat("CPU ", frameStat);
+    for (const auto& stat : cpuStats) {
+        printStat("CPU ", stat);
+    }
+    for (const auto& stat : gpuStats) {
+        printStat("GPU ", stat);
+    }
+    out << std::defaultfloat;
+}
+
+// ============================================================================
+// ProfileScope Implementation
+// ============================================================================
+
+ProfileScope::ProfileScope(const char* name) {
+    g_Profiler.BeginZone(name);
+}
+
+ProfileScope::~ProfileScope() {
+    g_Profiler.EndZone();
+}
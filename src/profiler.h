@@ -0,0 +1,167 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// ============================================================================
+// Galaxies Away - Frame Profiler
+// Lightweight CPU zone timing plus GPU pass timings reported by the renderer,
+// with optional capture to a Chrome trace-event JSON file
+// ============================================================================
+
+#include "utils.h"
+#include "memtrack.h"
+#include <mutex>
+#include <atomic>
+
+// ============================================================================
+// Profile Statistics
+// ============================================================================
+
+struct ProfileStat {
+    const char* name;
+    double lastMs;      // Time spent in the most recent frame
+    double avgMs;       // Smoothed average for the overlay
+    double totalMs;     // Accumulated over the whole session
+    double maxMs;
+    int frames;         // Frames this zone was recorded in
+    
+    // Heap allocations made directly in this zone (children excluded)
+    AllocStats lastAllocs;
+    AllocStats totalAllocs;
+    uint64_t maxAllocs;
+    
+    ProfileStat() : name(""), lastMs(0.0), avgMs(0.0), totalMs(0.0), maxMs(0.0), frames(0), maxAllocs(0) {}
+    explicit ProfileStat(const char* n) : name(n), lastMs(0.0), avgMs(0.0), totalMs(0.0), maxMs(0.0), frames(0), maxAllocs(0) {}
+};
+
+// Time and allocations gathered for one zone during the current frame
+struct ZoneSample {
+    double ms;
+    AllocStats allocs;
+    
+    ZoneSample() : ms(0.0) {}
+    ZoneSample(double m, const AllocStats& a) : ms(m), allocs(a) {}
+};
+
+// ============================================================================
+// Trace Event (one complete "X" or instant "i" event in the capture)
+// ============================================================================
+
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    int threadId;
+    double start;       // Seconds since the profiler epoch
+    double duration;    // Seconds; negative for instant events
+    uint64_t allocs;    // Allocations made directly in the zone
+};
+
+// ============================================================================
+// Profiler Class
+// ============================================================================
+
+class Profiler {
+public:
+    Profiler();
+    
+    // Frame management
+    void BeginFrame();
+    void EndFrame();
+    uint64_t GetFrameIndex() const { return frameIndex; }
+    
+    // CPU zones (use the PROFILE_ZONE macro rather than calling these directly)
+    void BeginZone(const char* name);
+    void EndZone();
+    
+    // GPU pass timings, resolved a few frames late by the renderer
+    void ReportGpuTime(const char* name, double ms);
+    void RecordGpuEvent(const char* name, double start, double ms);
+    
+    // Instant marker (level up, boss spawn, ...) shown on the calling thread's track
+    void Mark(const char* name);
+    
+    // Name the calling thread's track in trace captures
+    void SetThreadName(const std::string& name);
+    
+    // Trace capture: records the next frameCount frames and writes them to path
+    void StartCapture(int frameCount, const std::string& path);
+    void StopCapture();     // Writes whatever was recorded so far
+    bool IsCapturing() const { return captureState != CaptureState::IDLE; }
+    
+    // Results. Zone stats are copied under the lock, since other threads may
+    // add zones at any time; out keeps its storage from call to call.
+    void GetCpuStats(std::vector<ProfileStat>& out) const;
+    void GetGpuStats(std::vector<ProfileStat>& out) const;
+    double GetFrameMs() const { return frameStat.lastMs; }
+    const ProfileStat& GetFrameStat() const { return frameStat; }
+    double GetZoneMs(const char* name) const;     // Last frame's time in a CPU zone
+    void PrintSummary(std::ostream& out) const;
+    
+    // Seconds since the profiler was created
+    double Now() const;
+
+private:
+    enum class CaptureState {
+        IDLE,
+        PENDING,        // Requested; recording starts with the next frame
+        RECORDING,
+        DRAINING        // Waiting for late GPU results before writing
+    };
+    
+    ProfileStat* FindStat(std::vector<ProfileStat>& stats, const char* name);    // Null past MAX_ZONES
+    void AccumulateStat(ProfileStat& stat, const ZoneSample& sample);
+    int GetThreadId();
+    void WriteCapture();
+    
+    std::chrono::steady_clock::time_point epoch;
+    uint64_t frameIndex;
+    double frameStart;
+    AllocStats frameStartAllocs;
+    ProfileStat frameStat;
+    
+    // Zone samples gathered during the current frame. Stats are reserved up
+    // front and capped at MAX_ZONES, so adding a zone never reallocates them;
+    // zones past the cap are dropped with a warning.
+    static const int MAX_ZONES = 64;
+    std::vector<ProfileStat> cpuStats;
+    std::vector<ProfileStat> gpuStats;
+    std::vector<ZoneSample> frameSamples;
+    bool zoneLimitWarned;
+    
+    // Trace capture
+    std::atomic<CaptureState> captureState;
+    int captureFramesLeft;
+    double captureStart;
+    double captureEnd;
+    std::string capturePath;
+    std::vector<TraceEvent> traceEvents;
+    std::vector<std::pair<int, std::string>> threadNames;
+    int nextThreadId;
+    
+    // Zones may be recorded from any thread
+    mutable std::mutex mutex;
+};
+
+// ============================================================================
+// Scoped Zone Helper
+// ============================================================================
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+    
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+// ============================================================================
+// Global Profiler Access
+// ============================================================================
+
+extern Profiler g_Profiler;
+
+#endif // PROFILER_H
@@ -0,0 +1,273 @@
+// ============================================================================
+// Galaxies Away - Render Back Ends Without GL Implementation
+// ============================================================================
+
+#include "render_backends.h"
+#include <cstdio>
+
+// ============================================================================
+// Null Renderer Implementation
+// ============================================================================
+
+NullRenderer::NullRenderer()
+    : prefabCount(0)
+{
+}
+
+void NullRenderer::Initialize(int width, int height) {
+    windowWidth = width;
+    windowHeight = height;
+}
+
+int NullRenderer::CreatePrefab(const std::vector<PrefabPart>& parts) {
+    if (parts.empty()) return -1;
+    return prefabCount++;
+}
+
+std::shared_ptr<const TextLayout> NullRenderer::LayoutText(const std::string& text, float scale) {
+    auto layout = std::make_shared<TextLayout>();
+    layout->text = text;
+    layout->scale = scale;
+    return layout;
+}
+
+// ============================================================================
+// Recording Renderer Implementation
+// ============================================================================
+
+RecordingRenderer::RecordingRenderer() {
+    std::fill(drawCounts, drawCounts + static_cast<int>(RecordedDrawType::COUNT), 0);
+}
+
+void RecordingRenderer::BeginFrame() {
+    NullRenderer::BeginFrame();
+    draws.clear();
+    textChars.clear();
+    std::fill(drawCounts, drawCounts + static_cast<int>(RecordedDrawType::COUNT), 0);
+}
+
+RecordedDraw& RecordingRenderer::Record(RecordedDrawType type, bool world, const glm::vec2& position,
+                                        const glm::vec2& size, const glm::vec4& color) {
+    RecordedDraw draw;
+    draw.type = type;
+    draw.layer = layer;
+    draw.blend = blendMode;
+    draw.world = world;
+    draw.depth = layerDepth;
+    draw.id = -1;
+    draw.texture = 0;
+    draw.position = position;
+    draw.size = size;
+    draw.rotation = 0.0f;
+    draw.value = 0.0f;
+    draw.color = color;
+    draw.secondColor = glm::vec4(0.0f);
+    draw.textFirst = 0;
+    draw.textLength = 0;
+    draws.push_back(draw);
+    drawCounts[static_cast<int>(type)]++;
+    return draws.back();
+}
+
+std::string RecordingRenderer::GetDrawText(const RecordedDraw& draw) const {
+    if (draw.textLength == 0) return std::string();
+    return std::string(textChars.data() + draw.textFirst, draw.textLength);
+}
+
+const char* RecordingRenderer::GetDrawTypeName(RecordedDrawType type) {
+    switch (type) {
+        case RecordedDrawType::SPRITE:              return "sprite";
+        case RecordedDrawType::ATLAS_SPRITE:        return "atlas_sprite";
+        case RecordedDrawType::PREFAB:              return "prefab";
+        case RecordedDrawType::QUAD:                return "quad";
+        case RecordedDrawType::CIRCLE:              return "circle";
+        case RecordedDrawType::RING:                return "ring";
+        case RecordedDrawType::GLOW:                return "glow";
+        case RecordedDrawType::LINE:                return "line";
+        case RecordedDrawType::RECT:                return "rect";
+        case RecordedDrawType::RECT_OUTLINE:        return "rect_outline";
+        case RecordedDrawType::PROGRESS_BAR:        return "progress_bar";
+        case RecordedDrawType::HEALTH_BAR:          return "health_bar";
+        case RecordedDrawType::PUSH_CLIP:           return "push_clip";
+        case RecordedDrawType::POP_CLIP:            return "pop_clip";
+        case RecordedDrawType::TEXT:                return "text";
+        case RecordedDrawType::STARFIELD:           return "starfield";
+        case RecordedDrawType::PARTICLE:            return "particle";
+        case RecordedDrawType::GPU_PARTICLE_STEP:   return "gpu_particle_step";
+        case RecordedDrawType::GPU_PARTICLE_DRAW:   return "gpu_particle_draw";
+        case RecordedDrawType::GPU_PARTICLE_CLEAR:  return "gpu_particle_clear";
+        default:                                    return "unknown";
+    }
+}
+
+bool RecordingRenderer::WriteDraws(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        std::cerr << "Failed to write draw list: " << path << std::endl;
+        return false;
+    }
+    
+    std::fprintf(file, "# %zu draws: type layer blend depth space id texture position size rotation value color "
+                       "second_color [text]\n", draws.size());
+    for (const RecordedDraw& draw : draws) {
+        std::fprintf(file, "%s %d %d %u %s %d %u (%.2f %.2f) (%.2f %.2f) %.3f %.3f (%.3f %.3f %.3f %.3f) "
+                           "(%.3f %.3f %.3f %.3f)",
+                     GetDrawTypeName(draw.type), static_cast<int>(draw.layer), static_cast<int>(draw.blend),
+                     static_cast<unsigned int>(draw.depth), draw.world ? "world" : "screen", draw.id, draw.texture,
+                     draw.position.x, draw.position.y, draw.size.x, draw.size.y, draw.rotation, draw.value,
+                     draw.color.r, draw.color.g, draw.color.b, draw.color.a,
+                     draw.secondColor.r, draw.secondColor.g, draw.secondColor.b, draw.secondColor.a);
+        if (draw.textLength > 0) {
+            std::fprintf(file, " \"%.*s\"", static_cast<int>(draw.textLength), textChars.data() + draw.textFirst);
+        }
+        std::fputc('\n', file);
+    }
+    
+    bool ok = std::ferror(file) == 0;
+    std::fclose(file);
+    return ok;
+}
+
+void RecordingRenderer::DrawSprite(const glm::vec2& position, const glm::vec2& size, float rotation,
+                                   const glm::vec4& color, Texture* texture) {
+    RecordedDraw& draw = Record(RecordedDrawType::SPRITE, false, position, size, color);
+    draw.rotation = rotation;
+    draw.texture = texture ? texture->textureID : 0;
+}
+
+void RecordingRenderer::DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
+                                        const glm::vec4& color, Texture* texture) {
+    DrawSpriteWorld(position, size, rotation, color, texture, false);
+}
+
+void RecordingRenderer::DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
+                                        const glm::vec4& color, Texture* texture, bool flipHorizontal) {
+    // A flipped sprite is recorded with a negative width
+    glm::vec2 signedSize(flipHorizontal ? -size.x : size.x, size.y);
+    RecordedDraw& draw = Record(RecordedDrawType::SPRITE, true, position, signedSize, color);
+    draw.rotation = rotation;
+    draw.texture = texture ? texture->textureID : 0;
+}
+
+void RecordingRenderer::DrawSpriteWorld(int sprite, const glm::vec2& position, const glm::vec2& size,
+                                        float rotation, const glm::vec4& color, bool flipHorizontal) {
+    glm::vec2 signedSize(flipHorizontal ? -size.x : size.x, size.y);
+    RecordedDraw& draw = Record(RecordedDrawType::ATLAS_SPRITE, true, position, signedSize, color);
+    draw.rotation = rotation;
+    draw.id = sprite;
+}
+
+void RecordingRenderer::DrawPrefabWorld(int prefab, const glm::vec2& position, const glm::vec2& scale,
+                                        float rotation, const glm::vec4& tint, float spin) {
+    RecordedDraw& draw = Record(RecordedDrawType::PREFAB, true, position, scale, tint);
+    draw.rotation = rotation;
+    draw.value = spin;
+    draw.id = prefab;
+}
+
+void RecordingRenderer::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) {
+    Record(RecordedDrawType::QUAD, false, position, size, color);
+}
+
+void RecordingRenderer::DrawQuadWorld(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) {
+    Record(RecordedDrawType::QUAD, true, position, size, color);
+}
+
+void RecordingRenderer::DrawCircle(const glm::vec2& position, float radius, const glm::vec4& color) {
+    Record(RecordedDrawType::CIRCLE, false, position, glm::vec2(radius, 0.0f), color);
+}
+
+void RecordingRenderer::DrawCircleWorld(const glm::vec2& position, float radius, const glm::vec4& color) {
+    Record(RecordedDrawType::CIRCLE, true, position, glm::vec2(radius, 0.0f), color);
+}
+
+void RecordingRenderer::DrawRingWorld(const glm::vec2& position, float radius, float thickness,
+                                      const glm::vec4& color, float glow) {
+    Record(RecordedDrawType::RING, true, position, glm::vec2(radius, thickness), color).value = glow;
+}
+
+void RecordingRenderer::DrawGlowWorld(const glm::vec2& position, float radius, float glow,
+                                      const glm::vec4& color, float core) {
+    Record(RecordedDrawType::GLOW, true, position, glm::vec2(radius, glow), color).value = core;
+}
+
+void RecordingRenderer::DrawLine(const glm::vec2& start, const glm::vec2& end, float thickness,
+                                 const glm::vec4& color) {
+    Record(RecordedDrawType::LINE, false, start, end, color).value = thickness;
+}
+
+void RecordingRenderer::DrawLineWorld(const glm::vec2& start, const glm::vec2& end, float thickness,
+                                      const glm::vec4& color) {
+    Record(RecordedDrawType::LINE, true, start, end, color).value = thickness;
+}
+
+void RecordingRenderer::DrawRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) {
+    Record(RecordedDrawType::RECT, false, position, size, color);
+}
+
+void RecordingRenderer::DrawRectOutline(const glm::vec2& position, const glm::vec2& size, float thickness,
+                                        const glm::vec4& color) {
+    Record(RecordedDrawType::RECT_OUTLINE, false, position, size, color).value = thickness;
+}
+
+void RecordingRenderer::DrawProgressBar(const glm::vec2& position, const glm::vec2& size, float progress,
+                                        const glm::vec4& fillColor, const glm::vec4& bgColor) {
+    RecordedDraw& draw = Record(RecordedDrawType::PROGRESS_BAR, false, position, size, fillColor);
+    draw.value = progress;
+    draw.secondColor = bgColor;
+}
+
+void RecordingRenderer::DrawHealthBar(const glm::vec2& position, const glm::vec2& size, float fraction,
+                                      const glm::vec4& fillColor, const glm::vec4& bgColor) {
+    RecordedDraw& draw = Record(RecordedDrawType::HEALTH_BAR, false, position, size, fillColor);
+    draw.value = fraction;
+    draw.secondColor = bgColor;
+}
+
+void RecordingRenderer::PushClipRect(const glm::vec2& position, const glm::vec2& size) {
+    Record(RecordedDrawType::PUSH_CLIP, false, position, size, glm::vec4(0.0f));
+}
+
+void RecordingRenderer::PopClipRect() {
+    Record(RecordedDrawType::POP_CLIP, false, glm::vec2(0.0f), glm::vec2(0.0f), glm::vec4(0.0f));
+}
+
+void RecordingRenderer::DrawText(const std::string& text, const glm::vec2& position, float scale,
+                                 const glm::vec4& color) {
+    RecordedDraw& draw = Record(RecordedDrawType::TEXT, false, position, glm::vec2(scale, 0.0f), color);
+    draw.textFirst = static_cast<uint32_t>(textChars.size());
+    draw.textLength = static_cast<uint32_t>(text.size());
+    textChars.insert(textChars.end(), text.begin(), text.end());
+}
+
+void RecordingRenderer::DrawText(const TextLayout& layout, const glm::vec2& position, const glm::vec4& color) {
+    DrawText(layout.text, position, layout.scale, color);
+}
+
+void RecordingRenderer::DrawTextCached(const std::string& text, const glm::vec2& position, float scale,
+                                       const glm::vec4& color) {
+    DrawText(text, position, scale, color);
+}
+
+void RecordingRenderer::DrawStarfield(float time) {
+    Record(RecordedDrawType::STARFIELD, false, glm::vec2(0.0f), glm::vec2(0.0f), glm::vec4(1.0f)).value = time;
+}
+
+void RecordingRenderer::DrawParticle(const glm::vec2& position, float size, const glm::vec4& color) {
+    Record(RecordedDrawType::PARTICLE, true, position, glm::vec2(size, 0.0f), color);
+}
+
+void RecordingRenderer::SimulateGpuParticles(float deltaTime, const GpuParticle*, int spawnCount) {
+    RecordedDraw& draw = Record(RecordedDrawType::GPU_PARTICLE_STEP, true, glm::vec2(0.0f), glm::vec2(0.0f),
+                                glm::vec4(0.0f));
+    draw.value = deltaTime;
+    draw.id = spawnCount;
+}
+
+void RecordingRenderer::DrawGpuParticles() {
+    Record(RecordedDrawType::GPU_PARTICLE_DRAW, true, glm::vec2(0.0f), glm::vec2(0.0f), glm::vec4(0.0f));
+}
+
+void RecordingRenderer::ClearGpuParticles() {
+    Record(RecordedDrawType::GPU_PARTICLE_CLEAR, true, glm::vec2(0.0f), glm::vec2(0.0f), glm::vec4(0.0f));
+}
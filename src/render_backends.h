@@ -0,0 +1,189 @@
+#ifndef RENDER_BACKENDS_H
+#define RENDER_BACKENDS_H
+
+// ============================================================================
+// Galaxies Away - Render Back Ends Without GL
+// The null back end drops every draw: running the render code against it
+// measures what the game itself spends issuing a frame. The recording back
+// end keeps each draw call as it was made, for counting and for diffing one
+// frame against another (or a run against an earlier one).
+// ============================================================================
+
+#include "renderer.h"
+
+// ============================================================================
+// Null Renderer
+// ============================================================================
+
+class NullRenderer : public IRenderer {
+public:
+    NullRenderer();
+    
+    // Viewport the camera and culling work with; no GL is touched
+    void Initialize(int windowWidth, int windowHeight);
+    
+    void DrawSprite(const glm::vec2&, const glm::vec2&, float, const glm::vec4&, Texture* = nullptr) override {}
+    void DrawSpriteWorld(const glm::vec2&, const glm::vec2&, float, const glm::vec4&, Texture* = nullptr) override {}
+    void DrawSpriteWorld(const glm::vec2&, const glm::vec2&, float, const glm::vec4&, Texture*, bool) override {}
+    
+    // No atlas: entities fall back to their untextured look
+    const AtlasSprite* GetSprite(int) const override { return nullptr; }
+    void DrawSpriteWorld(int, const glm::vec2&, const glm::vec2&, float, const glm::vec4&, bool = false) override {}
+    
+    // Hands out IDs without building meshes, so prefab draws take their usual path
+    int CreatePrefab(const std::vector<PrefabPart>& parts) override;
+    void DrawPrefabWorld(int, const glm::vec2&, const glm::vec2&, float, const glm::vec4&, float = 0.0f) override {}
+    
+    void DrawQuad(const glm::vec2&, const glm::vec2&, const glm::vec4&) override {}
+    void DrawQuadWorld(const glm::vec2&, const glm::vec2&, const glm::vec4&) override {}
+    void DrawCircle(const glm::vec2&, float, const glm::vec4&) override {}
+    void DrawCircleWorld(const glm::vec2&, float, const glm::vec4&) override {}
+    void DrawRingWorld(const glm::vec2&, float, float, const glm::vec4&, float = 0.0f) override {}
+    void DrawGlowWorld(const glm::vec2&, float, float, const glm::vec4&, float = 0.0f) override {}
+    void DrawLine(const glm::vec2&, const glm::vec2&, float, const glm::vec4&) override {}
+    void DrawLineWorld(const glm::vec2&, const glm::vec2&, float, const glm::vec4&) override {}
+    
+    void DrawRect(const glm::vec2&, const glm::vec2&, const glm::vec4&) override {}
+    void DrawRectOutline(const glm::vec2&, const glm::vec2&, float, const glm::vec4&) override {}
+    void DrawProgressBar(const glm::vec2&, const glm::vec2&, float, const glm::vec4&, const glm::vec4&) override {}
+    void DrawHealthBar(const glm::vec2&, const glm::vec2&, float, const glm::vec4&, const glm::vec4&) override {}
+    void PushClipRect(const glm::vec2&, const glm::vec2&) override {}
+    void PopClipRect() override {}
+    
+    // Layouts carry the text and scale but no glyph quads (there is no font)
+    void DrawText(const std::string&, const glm::vec2&, float, const glm::vec4&) override {}
+    std::shared_ptr<const TextLayout> LayoutText(const std::string& text, float scale) override;
+    void DrawText(const TextLayout&, const glm::vec2&, const glm::vec4&) override {}
+    void DrawTextCached(const std::string&, const glm::vec2&, float, const glm::vec4&) override {}
+    
+    void DrawStarfield(float) override {}
+    
+    void DrawParticle(const glm::vec2&, float, const glm::vec4&) override {}
+    void FlushParticles() override {}
+    void SimulateGpuParticles(float, const GpuParticle*, int) override {}
+    void DrawGpuParticles() override {}
+    void ClearGpuParticles() override {}
+
+private:
+    int prefabCount;
+};
+
+// ============================================================================
+// Recording Renderer
+// Draws of the current frame (or, after EndFrame, the last one) are kept in
+// call order, each with the layer and blend mode it was made in. Storage is
+// reused from frame to frame.
+// ============================================================================
+
+enum class RecordedDrawType : uint8_t {
+    SPRITE,             // texture = GL name of the texture (0 = solid)
+    ATLAS_SPRITE,       // id = atlas sprite
+    PREFAB,             // id = prefab, size = scale, value = spin
+    QUAD,
+    CIRCLE,             // size.x = radius
+    RING,               // size = radius, thickness; value = glow
+    GLOW,               // size = radius, glow; value = core
+    LINE,               // position = start, size = end, value = thickness
+    RECT,
+    RECT_OUTLINE,       // value = thickness
+    PROGRESS_BAR,       // value = progress, secondColor = background
+    HEALTH_BAR,         // value = fraction, secondColor = background
+    PUSH_CLIP,
+    POP_CLIP,
+    TEXT,               // size.x = scale
+    STARFIELD,          // value = time
+    PARTICLE,           // size.x = size
+    GPU_PARTICLE_STEP,  // value = delta time, id = spawns
+    GPU_PARTICLE_DRAW,
+    GPU_PARTICLE_CLEAR,
+    COUNT
+};
+
+struct RecordedDraw {
+    RecordedDrawType type;
+    RenderLayer layer;
+    BlendMode blend;
+    bool world;             // World space (false = screen space)
+    uint16_t depth;
+    int id;
+    unsigned int texture;
+    glm::vec2 position;
+    glm::vec2 size;
+    float rotation;
+    float value;
+    glm::vec4 color;
+    glm::vec4 secondColor;
+    uint32_t textFirst;     // Text of TEXT draws, in the recorder's character buffer
+    uint32_t textLength;
+};
+
+class RecordingRenderer : public NullRenderer {
+public:
+    RecordingRenderer();
+    
+    void BeginFrame() override;
+    
+    const std::vector<RecordedDraw>& GetDraws() const { return draws; }
+    int GetDrawCount(RecordedDrawType type) const { return drawCounts[static_cast<int>(type)]; }
+    std::string GetDrawText(const RecordedDraw& draw) const;
+    static const char* GetDrawTypeName(RecordedDrawType type);
+    
+    // One line per draw, in call order, so two recordings can be compared with diff
+    bool WriteDraws(const std::string& path) const;
+    
+    void DrawSprite(const glm::vec2& position, const glm::vec2& size, float rotation,
+                    const glm::vec4& color, Texture* texture = nullptr) override;
+    void DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
+                         const glm::vec4& color, Texture* texture = nullptr) override;
+    void DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
+                         const glm::vec4& color, Texture* texture, bool flipHorizontal) override;
+    void DrawSpriteWorld(int sprite, const glm::vec2& position, const glm::vec2& size, float rotation,
+                         const glm::vec4& color, bool flipHorizontal = false) override;
+    void DrawPrefabWorld(int prefab, const glm::vec2& position, const glm::vec2& scale, float rotation,
+                         const glm::vec4& tint, float spin = 0.0f) override;
+    
+    void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) override;
+    void DrawQuadWorld(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) override;
+    void DrawCircle(const glm::vec2& position, float radius, const glm::vec4& color) override;
+    void DrawCircleWorld(const glm::vec2& position, float radius, const glm::vec4& color) override;
+    void DrawRingWorld(const glm::vec2& position, float radius, float thickness, const glm::vec4& color,
+                       float glow = 0.0f) override;
+    void DrawGlowWorld(const glm::vec2& position, float radius, float glow, const glm::vec4& color,
+                       float core = 0.0f) override;
+    void DrawLine(const glm::vec2& start, const glm::vec2& end, float thickness, const glm::vec4& color) override;
+    void DrawLineWorld(const glm::vec2& start, const glm::vec2& end, float thickness,
+                       const glm::vec4& color) override;
+    
+    void DrawRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) override;
+    void DrawRectOutline(const glm::vec2& position, const glm::vec2& size, float thickness,
+                         const glm::vec4& color) override;
+    void DrawProgressBar(const glm::vec2& position, const glm::vec2& size, float progress,
+                         const glm::vec4& fillColor, const glm::vec4& bgColor) override;
+    void DrawHealthBar(const glm::vec2& position, const glm::vec2& size, float fraction,
+                       const glm::vec4& fillColor, const glm::vec4& bgColor) override;
+    void PushClipRect(const glm::vec2& position, const glm::vec2& size) override;
+    void PopClipRect() override;
+    
+    void DrawText(const std::string& text, const glm::vec2& position, float scale,
+                  const glm::vec4& color) override;
+    void DrawText(const TextLayout& layout, const glm::vec2& position, const glm::vec4& color) override;
+    void DrawTextCached(const std::string& text, const glm::vec2& position, float scale,
+                        const glm::vec4& color) override;
+    
+    void DrawStarfield(float time) override;
+    
+    void DrawParticle(const glm::vec2& position, float size, const glm::vec4& color) override;
+    void SimulateGpuParticles(float deltaTime, const GpuParticle* spawns, int spawnCount) override;
+    void DrawGpuParticles() override;
+    void ClearGpuParticles() override;
+
+private:
+    RecordedDraw& Record(RecordedDrawType type, bool world, const glm::vec2& position, const glm::vec2& size,
+                         const glm::vec4& color);
+    
+    std::vector<RecordedDraw> draws;
+    std::vector<char> textChars;
+    int drawCounts[static_cast<int>(RecordedDrawType::COUNT)];
+};
+
+#endif // RENDER_BACKENDS_H
@@ -0,0 +1,345 @@
+// ============================================================================
+// Galaxies Away - Render Thread Implementation
+// ============================================================================
+
+#include "render_thread.h"
+#include "profiler.h"
+
+// ============================================================================
+// Render Command Buffer Implementation
+// ============================================================================
+
+void RenderCommandBuffer::Clear() {
+    commands.clear();
+    runStarts.clear();
+    order.clear();
+    cameras.clear();
+    sprites.clear();
+    shapes.clear();
+    prefabInstances.clear();
+    uiRects.clear();
+    textVertices.clear();
+    particles.clear();
+    spawns.clear();
+}
+
+RenderCommand& RenderCommandBuffer::Add(RenderCommandType type, uint64_t key, size_t first) {
+    RenderCommand command;
+    command.key = key;
+    command.type = type;
+    command.first = static_cast<uint32_t>(first);
+    command.count = 0;
+    command.value = 0.0f;
+    command.color = 0;
+    command.offset = glm::vec2(0.0f);
+    command.texture = nullptr;
+    command.prefab = -1;
+    commands.push_back(command);
+    return commands.back();
+}
+
+void RenderCommandBuffer::SetCamera(const RenderCamera& camera) {
+    // Draws are only reordered between camera changes; the camera sorts first in its run
+    runStarts.push_back(static_cast<uint32_t>(commands.size()));
+    Add(RenderCommandType::CAMERA, 0, cameras.size());
+    cameras.push_back(camera);
+}
+
+void RenderCommandBuffer::AddSprite(const SpriteInstance& instance, Texture* texture, uint64_t key) {
+    // Consecutive sprites with the same key and texture share one command
+    if (commands.empty() || commands.back().type != RenderCommandType::SPRITES ||
+        commands.back().key != key || commands.back().texture != texture) {
+        Add(RenderCommandType::SPRITES, key, sprites.size()).texture = texture;
+    }
+    sprites.push_back(instance);
+    commands.back().count++;
+}
+
+void RenderCommandBuffer::AddShape(const ShapeInstance& instance, uint64_t key) {
+    if (commands.empty() || commands.back().type != RenderCommandType::SHAPES ||
+        commands.back().key != key) {
+        Add(RenderCommandType::SHAPES, key, shapes.size());
+    }
+    shapes.push_back(instance);
+    commands.back().count++;
+}
+
+void RenderCommandBuffer::AddPrefab(const PrefabInstance& instance, int prefab, uint64_t key) {
+    if (commands.empty() || commands.back().type != RenderCommandType::PREFABS ||
+        commands.back().key != key || commands.back().prefab != prefab) {
+        Add(RenderCommandType::PREFABS, key, prefabInstances.size()).prefab = prefab;
+    }
+    prefabInstances.push_back(instance);
+    commands.back().count++;
+}
+
+void RenderCommandBuffer::AddUiRect(const UiRect& rect, uint64_t key) {
+    if (commands.empty() || commands.back().type != RenderCommandType::UI_RECTS ||
+        commands.back().key != key) {
+        Add(RenderCommandType::UI_RECTS, key, uiRects.size());
+    }
+    uiRects.push_back(rect);
+    commands.back().count++;
+}
+
+TextVertex* RenderCommandBuffer::AddText(size_t count, const glm::vec2& offset, uint32_t color, uint64_t key) {
+    RenderCommand& command = Add(RenderCommandType::TEXT, key, textVertices.size());
+    command.count = static_cast<uint32_t>(count);
+    command.offset = offset;
+    command.color = color;
+    textVertices.resize(textVertices.size() + count);
+    return textVertices.data() + command.first;
+}
+
+void RenderCommandBuffer::TrimText(size_t unused) {
+    textVertices.resize(textVertices.size() - unused);
+    commands.back().count -= static_cast<uint32_t>(unused);
+}
+
+void RenderCommandBuffer::AddParticle(const ParticleVertex& vertex, uint64_t key) {
+    if (commands.empty() || commands.back().type != RenderCommandType::PARTICLES ||
+        commands.back().key != key) {
+        Add(RenderCommandType::PARTICLES, key, particles.size());
+    }
+    particles.push_back(vertex);
+    commands.back().count++;
+}
+
+void RenderCommandBuffer::DrawStarfield(float time, uint64_t key) {
+    Add(RenderCommandType::STARFIELD, key).value = time;
+}
+
+void RenderCommandBuffer::SimulateGpuParticles(float deltaTime, const GpuParticle* newSpawns, int spawnCount,
+                                               uint64_t key) {
+    RenderCommand& command = Add(RenderCommandType::GPU_PARTICLES_SIMULATE, key, spawns.size());
+    command.count = static_cast<uint32_t>(spawnCount);
+    command.value = deltaTime;
+    spawns.insert(spawns.end(), newSpawns, newSpawns + spawnCount);
+}
+
+void RenderCommandBuffer::DrawGpuParticles(uint64_t key) {
+    Add(RenderCommandType::GPU_PARTICLES_DRAW, key);
+}
+
+void RenderCommandBuffer::ClearGpuParticles(uint64_t key) {
+    Add(RenderCommandType::GPU_PARTICLES_CLEAR, key);
+}
+
+void RenderCommandBuffer::Sort() {
+    const size_t count = commands.size();
+    sortEntries.resize(count);
+    sortScratch.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        sortEntries[i].key = commands[i].key;
+        sortEntries[i].command = static_cast<uint32_t>(i);
+    }
+    
+    // Each run between camera changes is sorted on its own
+    size_t runStart = 0;
+    for (size_t run = 0; run <= runStarts.size(); ++run) {
+        size_t runEnd = run < runStarts.size() ? runStarts[run] : count;
+        if (runEnd > runStart) {
+            RadixSort(sortEntries.data() + runStart, sortScratch.data() + runStart, runEnd - runStart);
+        }
+        runStart = runEnd;
+    }
+    
+    order.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = sortEntries[i].command;
+    }
+}
+
+void RenderCommandBuffer::RadixSort(SortEntry* entries, SortEntry* scratch, size_t count) {
+    // LSD radix sort, one byte per pass; stable, so equal keys keep recording order.
+    // All histograms are gathered up front, and bytes every key shares are skipped
+    // (the low bytes are mostly zero).
+    size_t histograms[8][256] = {};
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t key = entries[i].key;
+        for (int byte = 0; byte < 8; ++byte) {
+            histograms[byte][(key >> (byte * 8)) & 0xFF]++;
+        }
+    }
+    
+    SortEntry* source = entries;
+    SortEntry* target = scratch;
+    for (int byte = 0; byte < 8; ++byte) {
+        size_t* histogram = histograms[byte];
+        if (histogram[(source[0].key >> (byte * 8)) & 0xFF] == count) continue;
+        
+        size_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            size_t bucketSize = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketSize;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            target[histogram[(source[i].key >> (byte * 8)) & 0xFF]++] = source[i];
+        }
+        std::swap(source, target);
+    }
+    
+    // An odd number of passes leaves the result in the scratch array
+    if (source != entries) {
+        std::copy(source, source + count, entries);
+    }
+}
+
+void RenderCommandBuffer::Replay(Renderer& renderer) const {
+    for (uint32_t index : order) {
+        const RenderCommand& command = commands[index];
+        if (command.type != RenderCommandType::CAMERA) {
+            // Both only flush the batches when they actually change
+            renderer.SubmitGpuPass(GetLayerPass(SortKey::Layer(command.key)));
+            renderer.SubmitBlendMode(SortKey::Blend(command.key));
+        }
+        
+        switch (command.type) {
+            case RenderCommandType::CAMERA:
+                renderer.SubmitCamera(cameras[command.first]);
+                break;
+            case RenderCommandType::SPRITES:
+                for (uint32_t i = 0; i < command.count; ++i) {
+                    renderer.SubmitSprite(sprites[command.first + i], command.texture);
+                }
+                break;
+            case RenderCommandType::SHAPES:
+                for (uint32_t i = 0; i < command.count; ++i) {
+                    renderer.SubmitShape(shapes[command.first + i]);
+                }
+                break;
+            case RenderCommandType::PREFABS:
+                for (uint32_t i = 0; i < command.count; ++i) {
+                    renderer.SubmitPrefab(prefabInstances[command.first + i], command.prefab);
+                }
+                break;
+            case RenderCommandType::UI_RECTS:
+                for (uint32_t i = 0; i < command.count; ++i) {
+                    renderer.SubmitUiRect(uiRects[command.first + i]);
+                }
+                break;
+            case RenderCommandType::TEXT:
+                renderer.SubmitText(textVertices.data() + command.first, command.count, command.offset, command.color);
+                break;
+            case RenderCommandType::PARTICLES:
+                for (uint32_t i = 0; i < command.count; ++i) {
+                    renderer.SubmitParticle(particles[command.first + i]);
+                }
+                break;
+            case RenderCommandType::STARFIELD:
+                renderer.SubmitStarfield(command.value);
+                break;
+            case RenderCommandType::GPU_PARTICLES_SIMULATE:
+                renderer.SubmitGpuParticleStep(command.value, spawns.data() + command.first,
+                                               static_cast<int>(command.count));
+                break;
+            case RenderCommandType::GPU_PARTICLES_DRAW:
+                renderer.SubmitGpuParticleDraw();
+                break;
+            case RenderCommandType::GPU_PARTICLES_CLEAR:
+                renderer.gpuParticles.Clear();
+                break;
+        }
+    }
+}
+
+// ============================================================================
+// Render Thread Implementation
+// ============================================================================
+
+RenderThread::RenderThread()
+    : renderer(nullptr)
+    , window(nullptr)
+    , submittedFrames(0)
+    , completedFrames(0)
+    , stopping(false)
+    , running(false)
+{
+}
+
+RenderThread::~RenderThread() {
+    Stop();
+}
+
+void RenderThread::Start(Renderer* target, GLFWwindow* targetWindow) {
+    if (running) return;
+    
+    renderer = target;
+    window = targetWindow;
+    submittedFrames = 0;
+    completedFrames = 0;
+    stopping = false;
+    
+    // A context can only be current on one thread at a time
+    glfwMakeContextCurrent(nullptr);
+    thread = std::thread(&RenderThread::Run, this);
+    running = true;
+}
+
+void RenderThread::Stop() {
+    if (!running) return;
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    frameSubmitted.notify_one();
+    thread.join();
+    running = false;
+    
+    glfwMakeContextCurrent(window);
+}
+
+RenderCommandBuffer* RenderThread::BeginFrame() {
+    PROFILE_ZONE("Render Wait");
+    
+    // A buffer is free again once the frame that last used it has been drawn
+    std::unique_lock<std::mutex> lock(mutex);
+    frameCompleted.wait(lock, [this] { return submittedFrames - completedFrames < BUFFER_COUNT; });
+    RenderCommandBuffer* buffer = &buffers[submittedFrames % BUFFER_COUNT];
+    lock.unlock();
+    
+    buffer->Clear();
+    return buffer;
+}
+
+void RenderThread::EndFrame() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        submittedFrames++;
+    }
+    frameSubmitted.notify_one();
+}
+
+void RenderThread::Run() {
+    glfwMakeContextCurrent(window);
+    g_Profiler.SetThreadName("Render");
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        frameSubmitted.wait(lock, [this] { return completedFrames < submittedFrames || stopping; });
+        if (completedFrames == submittedFrames) break; // Stopping, and everything submitted is drawn
+        
+        const RenderCommandBuffer& buffer = buffers[completedFrames % BUFFER_COUNT];
+        lock.unlock();
+        
+        {
+            PROFILE_ZONE("Submit");
+            renderer->BeginSubmission();
+            buffer.Replay(*renderer);
+            renderer->EndSubmission();
+        }
+        {
+            PROFILE_ZONE("Present");
+            glfwSwapBuffers(window);
+        }
+        
+        lock.lock();
+        completedFrames++;
+        frameCompleted.notify_one();
+    }
+    lock.unlock();
+    
+    glfwMakeContextCurrent(nullptr);
+}
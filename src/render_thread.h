@@ -0,0 +1,174 @@
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+// ============================================================================
+// Galaxies Away - Render Thread
+// The main thread records each frame's draws into a command buffer; a render
+// thread that owns the GL context replays it and presents. Recording frame
+// N+1 overlaps the GL submission (and vsync wait) of frame N. Without a
+// render thread the renderer records into a command buffer all the same, so
+// every frame is sorted before it reaches GL.
+// ============================================================================
+
+#include "renderer.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// ============================================================================
+// Sort Keys
+// 64 bits, most significant field first:
+//   layer (8) | blend mode (2) | program (4) | texture (16) | depth (16) | unused (18)
+// Textures are keyed by the low bits of their GL name; a collision only costs
+// a texture switch.
+// ============================================================================
+
+enum SortProgram {
+    SORT_PROGRAM_STARFIELD,
+    SORT_PROGRAM_SHAPES,        // Before sprites, so glows sit behind the sprites of their layer
+    SORT_PROGRAM_PREFABS,       // Texture field holds the prefab, so each prefab's instances group up
+    SORT_PROGRAM_SPRITES,
+    SORT_PROGRAM_PARTICLES,
+    SORT_PROGRAM_GPU_PARTICLES,
+    SORT_PROGRAM_UI,
+    SORT_PROGRAM_TEXT           // Last, so labels in a layer go over its shapes
+};
+
+namespace SortKey {
+    inline uint64_t Make(RenderLayer layer, BlendMode blend, int program, uint32_t texture, uint16_t depth) {
+        return (static_cast<uint64_t>(layer) << 56)
+             | (static_cast<uint64_t>(blend) << 54)
+             | (static_cast<uint64_t>(program & 0xF) << 50)
+             | (static_cast<uint64_t>(texture & 0xFFFF) << 34)
+             | (static_cast<uint64_t>(depth) << 18);
+    }
+    
+    inline RenderLayer Layer(uint64_t key) { return static_cast<RenderLayer>(key >> 56); }
+    inline BlendMode Blend(uint64_t key) { return static_cast<BlendMode>((key >> 54) & 0x3); }
+}
+
+// ============================================================================
+// Render Command Buffer
+// Commands in recording order; their payloads live in typed arrays that keep
+// their capacity between frames, so recording does not allocate once warm.
+// Sort orders the commands by key, each camera change starting a new run of
+// commands sorted on their own; Replay then walks them in that order.
+// ============================================================================
+
+enum class RenderCommandType : uint8_t {
+    CAMERA,                 // cameras[first]
+    SPRITES,                // sprites[first .. first + count), all with one texture (or solid)
+    SHAPES,                 // shapes[first .. first + count)
+    PREFABS,                // prefabInstances[first .. first + count), all of one prefab
+    UI_RECTS,               // uiRects[first .. first + count)
+    TEXT,                   // textVertices[first .. first + count), moved by offset and recolored
+    PARTICLES,              // particles[first .. first + count)
+    STARFIELD,              // value = time
+    GPU_PARTICLES_SIMULATE, // spawns[first .. first + count), value = delta time
+    GPU_PARTICLES_DRAW,
+    GPU_PARTICLES_CLEAR
+};
+
+struct RenderCommand {
+    uint64_t key;
+    RenderCommandType type;
+    uint32_t first;
+    uint32_t count;
+    float value;
+    uint32_t color;         // RGBA8 text color
+    glm::vec2 offset;       // Text origin
+    Texture* texture;
+    int prefab;
+};
+
+class RenderCommandBuffer {
+public:
+    void Clear();
+    
+    void SetCamera(const RenderCamera& camera);
+    void AddSprite(const SpriteInstance& instance, Texture* texture, uint64_t key);
+    void AddShape(const ShapeInstance& instance, uint64_t key);
+    void AddPrefab(const PrefabInstance& instance, int prefab, uint64_t key);
+    void AddUiRect(const UiRect& rect, uint64_t key);
+    // Room for count text vertices, drawn at offset in color; TrimText gives back what was not written
+    TextVertex* AddText(size_t count, const glm::vec2& offset, uint32_t color, uint64_t key);
+    void TrimText(size_t unused);
+    void AddParticle(const ParticleVertex& vertex, uint64_t key);
+    void DrawStarfield(float time, uint64_t key);
+    // GPU particle commands share the draw's key; the sort is stable, so they stay in call order
+    void SimulateGpuParticles(float deltaTime, const GpuParticle* spawns, int spawnCount, uint64_t key);
+    void DrawGpuParticles(uint64_t key);
+    void ClearGpuParticles(uint64_t key);
+    
+    // Radix sorts the recorded commands; call once recording is done
+    void Sort();
+    // Runs every command, in sorted order, against the renderer's GL back end
+    void Replay(Renderer& renderer) const;
+
+private:
+    struct SortEntry {
+        uint64_t key;
+        uint32_t command;
+    };
+    
+    RenderCommand& Add(RenderCommandType type, uint64_t key, size_t first = 0);
+    void RadixSort(SortEntry* entries, SortEntry* scratch, size_t count);
+    
+    std::vector<RenderCommand> commands;
+    std::vector<uint32_t> runStarts;    // Commands that start a sort run (camera changes)
+    std::vector<uint32_t> order;        // Command indices in sorted order
+    std::vector<SortEntry> sortEntries;
+    std::vector<SortEntry> sortScratch;
+    std::vector<RenderCamera> cameras;
+    std::vector<SpriteInstance> sprites;
+    std::vector<ShapeInstance> shapes;
+    std::vector<PrefabInstance> prefabInstances;
+    std::vector<UiRect> uiRects;
+    std::vector<TextVertex> textVertices;
+    std::vector<ParticleVertex> particles;
+    std::vector<GpuParticle> spawns;
+};
+
+// ============================================================================
+// Render Thread
+// ============================================================================
+
+class RenderThread {
+public:
+    // Frames the main thread may record ahead of the one being drawn; bounds
+    // the added latency and the memory held by command buffers
+    static const int MAX_FRAMES_AHEAD = 1;
+    
+    RenderThread();
+    ~RenderThread();
+    
+    // The window's context moves to the render thread until Stop
+    void Start(Renderer* renderer, GLFWwindow* window);
+    // Draws what was already submitted, then gives the context back to the caller
+    void Stop();
+    bool IsRunning() const { return running; }
+    
+    // Buffer to record the next frame into; waits while the queue is full
+    RenderCommandBuffer* BeginFrame();
+    // Hands the recorded frame over to the render thread
+    void EndFrame();
+
+private:
+    static const int BUFFER_COUNT = MAX_FRAMES_AHEAD + 1;
+    
+    void Run();
+    
+    Renderer* renderer;
+    GLFWwindow* window;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable frameSubmitted;
+    std::condition_variable frameCompleted;
+    RenderCommandBuffer buffers[BUFFER_COUNT];
+    uint64_t submittedFrames;   // Buffers are used round-robin by frame number
+    uint64_t completedFrames;
+    bool stopping;
+    bool running;
+};
+
+#endif // RENDER_THREAD_H
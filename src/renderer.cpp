@@ -3,14 +3,187 @@
 // ============================================================================
 
 #include "renderer.h"
+#include "render_thread.h"
+#include "profiler.h"
 #include <cstring>
+#include <filesystem>
 
 // Include stb_image for texture loading
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 // Global renderer pointer
-Renderer* g_Renderer = nullptr;
+IRenderer* g_Renderer = nullptr;
+
+namespace {
+    // Counters for the frame being recorded; published by Renderer::EndFrame
+    RenderStats frameStats;
+    
+    // Uniform block shared by all programs (see shaders: "uniform Camera")
+    const GLuint CAMERA_BLOCK_BINDING = 0;
+    
+    static_assert(sizeof(RenderCamera) == 128, "RenderCamera must match the std140 camera block");
+    
+    // Uniform IDs used by the renderer
+    const int U_MODEL = Shader::UniformID("model");
+    const int U_USE_TEXTURE = Shader::UniformID("useTexture");
+    const int U_TEXTURE_SAMPLER = Shader::UniformID("textureSampler");
+    const int U_TEXT_SAMPLER = Shader::UniformID("text");
+    const int U_TIME = Shader::UniformID("time");
+    const int U_VIEWPORT_SIZE = Shader::UniformID("viewportSize");
+    const int U_DELTA_TIME = Shader::UniformID("deltaTime");
+    
+    static_assert(sizeof(GpuParticle) == 17 * sizeof(float), "GpuParticle must match the captured varyings");
+    static_assert(sizeof(ParticleVertex) == 16, "ParticleVertex must stay compact");
+    static_assert(sizeof(SpriteInstance) == 36, "SpriteInstance must stay compact");
+    static_assert(sizeof(ShapeInstance) == 32, "ShapeInstance must stay compact");
+    static_assert(sizeof(PrefabVertex) == 28, "PrefabVertex must stay compact");
+    static_assert(sizeof(PrefabInstance) == 28, "PrefabInstance must stay compact");
+    static_assert(sizeof(UiRect) == 20, "UiRect must stay compact");
+    static_assert(sizeof(TextVertex) == 16, "TextVertex must stay compact");
+    
+    uint32_t PackColor(const glm::vec4& color) {
+        auto channel = [](float value) {
+            return static_cast<uint32_t>(Utils::Clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+        };
+        return channel(color.r) | channel(color.g) << 8 | channel(color.b) << 16 | channel(color.a) << 24;
+    }
+    
+    uint16_t PackUnorm16(float value) {
+        return static_cast<uint16_t>(Utils::Clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+    }
+    
+    // A whole texture, for sprites that are not in an atlas
+    const glm::vec4 FULL_UV_RECT(0.0f, 0.0f, 1.0f, 1.0f);
+    
+    // ========================================================================
+    // Vertex Layouts
+    // Every buffer's attribute setup comes from one of these tables. Streamed
+    // batches use packed formats: RGBA8 colors and unorm16 texture coordinates
+    // ========================================================================
+    
+    struct VertexAttribute {
+        GLuint location;
+        GLint components;
+        GLenum type;
+        GLboolean normalized;   // Integer types are read as 0..1
+        size_t offset;
+    };
+    
+    struct VertexLayout {
+        GLsizei stride;
+        GLuint divisor;         // 0 = per vertex, 1 = per instance
+        std::vector<VertexAttribute> attributes;
+    };
+    
+    // Static unit quad (unbatched sprite shader)
+    const VertexLayout QUAD_LAYOUT = { sizeof(Vertex), 0, {
+        { 0, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, position) },
+        { 1, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, texCoord) },
+        { 2, 4, GL_FLOAT, GL_FALSE, offsetof(Vertex, color) },
+    } };
+    
+    // Corners of the unit quad, shared by the instanced draws
+    const VertexLayout QUAD_CORNER_LAYOUT = { sizeof(Vertex), 0, {
+        { 0, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, position) },
+    } };
+    
+    // Sprites and UI rectangles (position and size stay float for world coordinates)
+    const VertexLayout SPRITE_LAYOUT = { sizeof(SpriteInstance), 1, {
+        { 3, 4, GL_FLOAT,          GL_FALSE, offsetof(SpriteInstance, position) },
+        { 4, 4, GL_UNSIGNED_SHORT, GL_TRUE,  offsetof(SpriteInstance, uvRect) },
+        { 5, 4, GL_UNSIGNED_BYTE,  GL_TRUE,  offsetof(SpriteInstance, color) },
+        { 6, 1, GL_FLOAT,          GL_FALSE, offsetof(SpriteInstance, rotation) },
+        { 7, 2, GL_UNSIGNED_BYTE,  GL_TRUE,  offsetof(SpriteInstance, textured) },
+    } };
+    
+    // Circles, rings and glows (center, radius and thickness in one vec4)
+    const VertexLayout SHAPE_LAYOUT = { sizeof(ShapeInstance), 1, {
+        { 3, 4, GL_FLOAT,          GL_FALSE, offsetof(ShapeInstance, position) },
+        { 4, 2, GL_FLOAT,          GL_FALSE, offsetof(ShapeInstance, glow) },
+        { 5, 4, GL_UNSIGNED_BYTE,  GL_TRUE,  offsetof(ShapeInstance, color) },
+        { 6, 1, GL_UNSIGNED_BYTE,  GL_TRUE,  offsetof(ShapeInstance, screenSpace) },
+    } };
+    
+    // Static prefab meshes (position and pivot in one vec4)
+    const VertexLayout PREFAB_MESH_LAYOUT = { sizeof(PrefabVertex), 0, {
+        { 0, 4, GL_FLOAT,          GL_FALSE, offsetof(PrefabVertex, position) },
+        { 1, 4, GL_UNSIGNED_BYTE,  GL_TRUE,  offsetof(PrefabVertex, color) },
+        { 2, 1, GL_FLOAT,          GL_FALSE, offsetof(PrefabVertex, spin) },
+        { 3, 1, GL_UNSIGNED_BYTE,  GL_TRUE,  offsetof(PrefabVertex, tinted) },
+    } };
+    
+    // Prefab instances (position and scale in one vec4, rotation and spin in one vec2)
+    const VertexLayout PREFAB_INSTANCE_LAYOUT = { sizeof(PrefabInstance), 1, {
+        { 4, 4, GL_FLOAT,          GL_FALSE, offsetof(PrefabInstance, position) },
+        { 5, 2, GL_FLOAT,          GL_FALSE, offsetof(PrefabInstance, rotation) },
+        { 6, 4, GL_UNSIGNED_BYTE,  GL_TRUE,  offsetof(PrefabInstance, tint) },
+    } };
+    
+    // UI rects (both corners in one vec4)
+    const VertexLayout UI_RECT_LAYOUT = { sizeof(UiRect), 1, {
+        { 3, 4, GL_FLOAT,          GL_FALSE, offsetof(UiRect, min) },
+        { 5, 4, GL_UNSIGNED_BYTE,  GL_TRUE,  offsetof(UiRect, color) },
+    } };
+    
+    const VertexLayout PARTICLE_LAYOUT = { sizeof(ParticleVertex), 0, {
+        { 0, 2, GL_FLOAT,         GL_FALSE, offsetof(ParticleVertex, position) },
+        { 1, 1, GL_FLOAT,         GL_FALSE, offsetof(ParticleVertex, size) },
+        { 2, 4, GL_UNSIGNED_BYTE, GL_TRUE,  offsetof(ParticleVertex, color) },
+    } };
+    
+    const VertexLayout TEXT_LAYOUT = { sizeof(TextVertex), 0, {
+        { 0, 2, GL_FLOAT,          GL_FALSE, offsetof(TextVertex, position) },
+        { 1, 2, GL_UNSIGNED_SHORT, GL_TRUE,  offsetof(TextVertex, texCoord) },
+        { 2, 4, GL_UNSIGNED_BYTE,  GL_TRUE,  offsetof(TextVertex, color) },
+    } };
+    
+    // GPU particle state; stays float because transform feedback writes it back
+    const VertexLayout GPU_PARTICLE_LAYOUT = { sizeof(GpuParticle), 0, {
+        { 0, 2, GL_FLOAT, GL_FALSE, offsetof(GpuParticle, position) },
+        { 1, 2, GL_FLOAT, GL_FALSE, offsetof(GpuParticle, velocity) },
+        { 2, 1, GL_FLOAT, GL_FALSE, offsetof(GpuParticle, age) },
+        { 3, 1, GL_FLOAT, GL_FALSE, offsetof(GpuParticle, lifetime) },
+        { 4, 1, GL_FLOAT, GL_FALSE, offsetof(GpuParticle, drag) },
+        { 5, 1, GL_FLOAT, GL_FALSE, offsetof(GpuParticle, startSize) },
+        { 6, 1, GL_FLOAT, GL_FALSE, offsetof(GpuParticle, endSize) },
+        { 7, 4, GL_FLOAT, GL_FALSE, offsetof(GpuParticle, startColor) },
+        { 8, 4, GL_FLOAT, GL_FALSE, offsetof(GpuParticle, endColor) },
+    } };
+    
+    const VertexLayout STAR_LAYOUT = { sizeof(Star), 1, {
+        { 3, 4, GL_FLOAT, GL_FALSE, offsetof(Star, position) },
+        { 4, 3, GL_FLOAT, GL_FALSE, offsetof(Star, twinkleSpeed) },
+    } };
+    
+    // Points the layout's attributes at a buffer, starting baseOffset bytes in
+    // (GL 3.3 has no base vertex/instance for every draw, so batches re-point)
+    void PointAttributes(const VertexLayout& layout, GLuint buffer, size_t baseOffset) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        for (const VertexAttribute& attribute : layout.attributes) {
+            glVertexAttribPointer(attribute.location, attribute.components, attribute.type, attribute.normalized,
+                                  layout.stride, reinterpret_cast<const void*>(baseOffset + attribute.offset));
+        }
+    }
+    
+    // Points and enables the layout on the bound vertex array
+    void SetupAttributes(const VertexLayout& layout, GLuint buffer) {
+        PointAttributes(layout, buffer, 0);
+        for (const VertexAttribute& attribute : layout.attributes) {
+            glEnableVertexAttribArray(attribute.location);
+            glVertexAttribDivisor(attribute.location, layout.divisor);
+        }
+    }
+    
+    // Starfield density: this many stars fill a 1280x720 view
+    const int STARS_AT_REFERENCE_RESOLUTION = 300;
+    
+    // Font atlas layout
+    const int FONT_PIXEL_SIZE = 48;
+    const int FONT_ATLAS_WIDTH = 1024;
+    const int FONT_ATLAS_MAX_HEIGHT = 1024;
+    const int FONT_ATLAS_PADDING = 1;      // Empty texels between glyphs so filtering never bleeds
+}
 
 // ============================================================================
 // Shader Implementation
@@ -52,6 +225,7 @@ bool Shader::LoadFromStrings(const std::string& vertexSource, const std::string&
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
     
+    ReflectUniforms();
     return true;
 }
 
@@ -66,32 +240,119 @@ bool Shader::LoadFromFiles(const std::string& vertexPath, const std::string& fra
     return LoadFromStrings(vertexSource, fragmentSource);
 }
 
+bool Shader::LoadFeedbackFromFile(const std::string& vertexPath, const std::vector<const char*>& varyings) {
+    std::string vertexSource = Utils::ReadFile(vertexPath);
+    if (vertexSource.empty()) return false;
+    
+    GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, vertexSource);
+    if (!vertexShader) return false;
+    
+    // Captured outputs must be declared before linking
+    programID = glCreateProgram();
+    glAttachShader(programID, vertexShader);
+    glTransformFeedbackVaryings(programID, static_cast<GLsizei>(varyings.size()), varyings.data(), GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(programID);
+    glDeleteShader(vertexShader);
+    
+    GLint success;
+    glGetProgramiv(programID, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(programID, 512, nullptr, infoLog);
+        std::cerr << "Transform feedback program linking failed (" << vertexPath << "):\n" << infoLog << std::endl;
+        return false;
+    }
+    
+    ReflectUniforms();
+    return true;
+}
+
+int Shader::UniformID(const std::string& name) {
+    static std::unordered_map<std::string, int> ids;
+    auto it = ids.find(name);
+    if (it != ids.end()) return it->second;
+    
+    int id = static_cast<int>(ids.size());
+    ids.emplace(name, id);
+    return id;
+}
+
+GLint Shader::GetUniformLocation(int id) const {
+    return id >= 0 && id < static_cast<int>(uniformLocations.size()) ? uniformLocations[id] : -1;
+}
+
+void Shader::ReflectUniforms() {
+    uniformLocations.clear();
+    
+    GLint count = 0;
+    glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        char name[128];
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(programID, i, sizeof(name), &length, &size, &type, name);
+        
+        // Members of uniform blocks have no location; they are set through the buffer
+        GLint location = glGetUniformLocation(programID, name);
+        if (location < 0) continue;
+        
+        // Arrays are reported as "name[0]"; register them under the bare name
+        std::string uniformName(name, length);
+        size_t bracket = uniformName.find('[');
+        if (bracket != std::string::npos) {
+            uniformName.resize(bracket);
+        }
+        
+        int id = UniformID(uniformName);
+        if (id >= static_cast<int>(uniformLocations.size())) {
+            uniformLocations.resize(id + 1, -1);
+        }
+        uniformLocations[id] = location;
+    }
+}
+
+bool Shader::BindUniformBlock(const char* blockName, GLuint binding) const {
+    GLuint index = glGetUniformBlockIndex(programID, blockName);
+    if (index == GL_INVALID_INDEX) return false;
+    
+    glUniformBlockBinding(programID, index, binding);
+    return true;
+}
+
 void Shader::Use() const {
     glUseProgram(programID);
+    frameStats.programSwitches++;
 }
 
-void Shader::SetInt(const std::string& name, int value) const {
-    glUniform1i(glGetUniformLocation(programID, name.c_str()), value);
+void Shader::SetInt(int id, int value) const {
+    glUniform1i(GetUniformLocation(id), value);
+    frameStats.uniformUploads++;
 }
 
-void Shader::SetFloat(const std::string& name, float value) const {
-    glUniform1f(glGetUniformLocation(programID, name.c_str()), value);
+void Shader::SetFloat(int id, float value) const {
+    glUniform1f(GetUniformLocation(id), value);
+    frameStats.uniformUploads++;
 }
 
-void Shader::SetVec2(const std::string& name, const glm::vec2& value) const {
-    glUniform2f(glGetUniformLocation(programID, name.c_str()), value.x, value.y);
+void Shader::SetVec2(int id, const glm::vec2& value) const {
+    glUniform2f(GetUniformLocation(id), value.x, value.y);
+    frameStats.uniformUploads++;
 }
 
-void Shader::SetVec3(const std::string& name, const glm::vec3& value) const {
-    glUniform3f(glGetUniformLocation(programID, name.c_str()), value.x, value.y, value.z);
+void Shader::SetVec3(int id, const glm::vec3& value) const {
+    glUniform3f(GetUniformLocation(id), value.x, value.y, value.z);
+    frameStats.uniformUploads++;
 }
 
-void Shader::SetVec4(const std::string& name, const glm::vec4& value) const {
-    glUniform4f(glGetUniformLocation(programID, name.c_str()), value.x, value.y, value.z, value.w);
+void Shader::SetVec4(int id, const glm::vec4& value) const {
+    glUniform4f(GetUniformLocation(id), value.x, value.y, value.z, value.w);
+    frameStats.uniformUploads++;
 }
 
-void Shader::SetMat4(const std::string& name, const glm::mat4& value) const {
-    glUniformMatrix4fv(glGetUniformLocation(programID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+void Shader::SetMat4(int id, const glm::mat4& value) const {
+    glUniformMatrix4fv(GetUniformLocation(id), 1, GL_FALSE, glm::value_ptr(value));
+    frameStats.uniformUploads++;
 }
 
 GLuint Shader::CompileShader(GLenum type, const std::string& source) {
@@ -160,7 +421,7 @@ bool Texture::CreateFromData(unsigned char* data, int w, int h, int ch) {
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
     
-    GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
+    GLenum format = (channels == 4) ? GL_RGBA : (channels == 1) ? GL_RED : GL_RGB;
     glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
     
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -187,204 +448,1229 @@ bool Texture::CreateSolid(int w, int h, const glm::vec4& color) {
 void Texture::Bind(int unit) const {
     glActiveTexture(GL_TEXTURE0 + unit);
     glBindTexture(GL_TEXTURE_2D, textureID);
+    frameStats.textureBinds++;
 }
 
 // ============================================================================
-// Renderer Implementation
+// Texture Atlas Implementation
 // ============================================================================
 
-Renderer::Renderer()
-    : windowWidth(0), windowHeight(0)
-    , cameraPosition(0.0f)
-    , cameraShakeOffset(0.0f)
-    , shakeIntensity(0.0f)
-    , shakeDuration(0.0f)
-    , shakeTimer(0.0f)
-    , quadVAO(0), quadVBO(0), quadEBO(0)
-    , particleVAO(0), particleVBO(0)
-    , textVAO(0), textVBO(0)
-    , ftLibrary(nullptr)
-    , ftFace(nullptr)
-    , fontInitialized(false)
-{
-}
-
-Renderer::~Renderer() {
-    Shutdown();
+namespace {
+    int NextPowerOfTwo(int value) {
+        int result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
 }
 
-bool Renderer::Initialize(int width, int height) {
-    windowWidth = width;
-    windowHeight = height;
-    
-    // Print OpenGL info
-    std::cout << "OpenGL Renderer: " << glGetString(GL_RENDERER) << std::endl;
-    std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
-    
-    // Set up OpenGL state
-    glViewport(0, 0, windowWidth, windowHeight);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_DEPTH_TEST);
-    
-    // Load shaders from files
-    if (!spriteShader.LoadFromFiles("shaders/vertex.glsl", "shaders/fragment.glsl")) {
-        std::cerr << "Failed to load sprite shader" << std::endl;
-        return false;
+bool TextureAtlas::LoadDirectory(const std::string& directory) {
+    namespace fs = std::filesystem;
+    
+    std::error_code error;
+    std::vector<fs::path> files;
+    for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (it->is_regular_file() && it->path().extension() == ".png") {
+            files.push_back(it->path());
+        }
     }
-    
-    if (!particleShader.LoadFromFiles("shaders/particle_vertex.glsl", "shaders/particle_fragment.glsl")) {
-        std::cerr << "Failed to load particle shader" << std::endl;
+    if (error) {
+        std::cerr << "Failed to read sprite directory: " << directory << " - " << error.message() << std::endl;
         return false;
     }
-    
-    if (!textShader.LoadFromFiles("shaders/text_vertex.glsl", "shaders/text_fragment.glsl")) {
-        std::cerr << "Failed to load text shader" << std::endl;
-        return false;
+    std::sort(files.begin(), files.end()); // Same layout on every run
+    
+    std::vector<Image> images;
+    stbi_set_flip_vertically_on_load(true); // Same orientation as Texture::LoadFromFile
+    for (const fs::path& file : files) {
+        int w, h, ch;
+        unsigned char* data = stbi_load(file.string().c_str(), &w, &h, &ch, 4);
+        if (!data) {
+            std::cerr << "Failed to load sprite: " << file.string() << " - " << stbi_failure_reason() << std::endl;
+            continue;
+        }
+        if (w + 2 * PADDING > MAX_PAGE_SIZE || h + 2 * PADDING > MAX_PAGE_SIZE) {
+            std::cerr << "Sprite too large for the atlas: " << file.string() << std::endl;
+            stbi_image_free(data);
+            continue;
+        }
+        
+        Image image;
+        image.name = file.stem().string();
+        image.width = w;
+        image.height = h;
+        image.pixels.assign(data, data + w * h * 4);
+        image.opaqueBounds = FindOpaqueBounds(image);
+        images.push_back(std::move(image));
+        stbi_image_free(data);
     }
+    if (images.empty()) return false;
     
-    // Initialize buffers
-    InitQuadBuffers();
-    InitParticleBuffers();
-    
-    // Create white texture for solid color rendering
-    whiteTexture.CreateSolid(4, 4, Colors::WHITE);
-    
-    // Initialize starfield
-    InitStarfield(300);
-    
-    // Initialize text rendering
-    InitTextRendering();
+    Clear();
+    Pack(images);
     
+    long long imageArea = 0, trimmedArea = 0;
+    for (const Image& image : images) {
+        imageArea += image.width * image.height;
+        trimmedArea += (image.opaqueBounds.z - image.opaqueBounds.x) * (image.opaqueBounds.w - image.opaqueBounds.y);
+    }
+    std::cout << "Packed " << sprites.size() << " sprites from " << directory << " into "
+              << pages.size() << " atlas page(s); trimmed quads cover "
+              << (100 * trimmedArea / imageArea) << "% of the images" << std::endl;
     return true;
 }
 
-void Renderer::Shutdown() {
-    // Clean up text rendering resources
-    if (textVAO) {
-        glDeleteVertexArrays(1, &textVAO);
-        textVAO = 0;
-    }
-    if (textVBO) {
-        glDeleteBuffers(1, &textVBO);
-        textVBO = 0;
+glm::ivec4 TextureAtlas::FindOpaqueBounds(const Image& image) {
+    glm::ivec4 bounds(image.width, image.height, 0, 0);
+    for (int y = 0; y < image.height; ++y) {
+        const unsigned char* row = &image.pixels[y * image.width * 4];
+        for (int x = 0; x < image.width; ++x) {
+            if (row[x * 4 + 3] == 0) continue;
+            bounds.x = std::min(bounds.x, x);
+            bounds.y = std::min(bounds.y, y);
+            bounds.z = std::max(bounds.z, x + 1);
+            bounds.w = std::max(bounds.w, y + 1);
+        }
     }
     
-    // Clean up font character textures
-    for (auto& pair : characters) {
-        glDeleteTextures(1, &pair.second.textureID);
+    // Fully transparent: an empty rectangle
+    if (bounds.z == 0) {
+        bounds = glm::ivec4(0);
     }
-    characters.clear();
+    return bounds;
+}
+
+void TextureAtlas::Pack(const std::vector<Image>& images) {
+    // Where each image goes; pages are sized once everything is placed
+    struct Placement {
+        int page;
+        int x, y;           // Corner of the padded cell
+    };
+    struct PageLayout {
+        int shelfY, shelfHeight;
+        int cursorX;
+        int usedWidth, usedHeight;
+    };
     
-    // Clean up FreeType resources
-    if (ftFace) {
-        FT_Done_Face(ftFace);
-        ftFace = nullptr;
+    std::vector<int> packOrder(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        packOrder[i] = static_cast<int>(i);
     }
-    if (ftLibrary) {
-        FT_Done_FreeType(ftLibrary);
-        ftLibrary = nullptr;
+    std::stable_sort(packOrder.begin(), packOrder.end(), [&images](int a, int b) {
+        return images[a].height > images[b].height;
+    });
+    
+    std::vector<Placement> placements(images.size());
+    std::vector<PageLayout> layouts;
+    for (int index : packOrder) {
+        const int cellWidth = images[index].width + 2 * PADDING;
+        const int cellHeight = images[index].height + 2 * PADDING;
+        
+        // Onto the open shelf of the first page with room, else a new shelf, else a new page
+        Placement& placement = placements[index];
+        placement.page = -1;
+        for (size_t page = 0; page < layouts.size() && placement.page < 0; ++page) {
+            PageLayout& layout = layouts[page];
+            if (layout.cursorX + cellWidth > MAX_PAGE_SIZE) {
+                layout.shelfY += layout.shelfHeight;
+                layout.shelfHeight = 0;
+                layout.cursorX = 0;
+            }
+            if (layout.shelfY + cellHeight > MAX_PAGE_SIZE) continue;
+            
+            placement.page = static_cast<int>(page);
+        }
+        if (placement.page < 0) {
+            PageLayout layout = {};
+            layouts.push_back(layout);
+            placement.page = static_cast<int>(layouts.size()) - 1;
+        }
+        
+        PageLayout& layout = layouts[placement.page];
+        placement.x = layout.cursorX;
+        placement.y = layout.shelfY;
+        layout.cursorX += cellWidth;
+        layout.shelfHeight = std::max(layout.shelfHeight, cellHeight);
+        layout.usedWidth = std::max(layout.usedWidth, layout.cursorX);
+        layout.usedHeight = std::max(layout.usedHeight, layout.shelfY + layout.shelfHeight);
     }
     
-    if (quadVAO) {
-        glDeleteVertexArrays(1, &quadVAO);
-        quadVAO = 0;
+    for (size_t page = 0; page < layouts.size(); ++page) {
+        const int pageWidth = NextPowerOfTwo(layouts[page].usedWidth);
+        const int pageHeight = NextPowerOfTwo(layouts[page].usedHeight);
+        std::vector<unsigned char> pixels(pageWidth * pageHeight * 4, 0);
+        
+        pages.emplace_back(new Texture());
+        Texture* texture = pages.back().get();
+        
+        for (size_t i = 0; i < images.size(); ++i) {
+            if (placements[i].page != static_cast<int>(page)) continue;
+            
+            // Copy the image with its edge pixels repeated out across the padding
+            const Image& image = images[i];
+            for (int y = 0; y < image.height + 2 * PADDING; ++y) {
+                int sourceY = Utils::Clamp(y - PADDING, 0, image.height - 1);
+                unsigned char* row = &pixels[((placements[i].y + y) * pageWidth + placements[i].x) * 4];
+                for (int x = 0; x < image.width + 2 * PADDING; ++x) {
+                    int sourceX = Utils::Clamp(x - PADDING, 0, image.width - 1);
+                    std::memcpy(row + x * 4, &image.pixels[(sourceY * image.width + sourceX) * 4], 4);
+                }
+            }
+            
+            AtlasSprite sprite;
+            sprite.name = image.name;
+            sprite.page = texture;
+            sprite.uvRect = glm::vec4(
+                static_cast<float>(placements[i].x + PADDING) / pageWidth,
+                static_cast<float>(placements[i].y + PADDING) / pageHeight,
+                static_cast<float>(placements[i].x + PADDING + image.width) / pageWidth,
+                static_cast<float>(placements[i].y + PADDING + image.height) / pageHeight);
+            sprite.size = glm::ivec2(image.width, image.height);
+            sprite.trimRect = glm::vec4(image.opaqueBounds) /
+                glm::vec4(image.width, image.height, image.width, image.height);
+            sprite.trimUVRect = glm::vec4(
+                static_cast<float>(placements[i].x + PADDING + image.opaqueBounds.x) / pageWidth,
+                static_cast<float>(placements[i].y + PADDING + image.opaqueBounds.y) / pageHeight,
+                static_cast<float>(placements[i].x + PADDING + image.opaqueBounds.z) / pageWidth,
+                static_cast<float>(placements[i].y + PADDING + image.opaqueBounds.w) / pageHeight);
+            spriteIDs[sprite.name] = static_cast<int>(sprites.size());
+            sprites.push_back(sprite);
+        }
+        
+        texture->CreateFromData(pixels.data(), pageWidth, pageHeight, 4);
     }
-    if (quadVBO) {
-        glDeleteBuffers(1, &quadVBO);
-        quadVBO = 0;
+}
+
+void TextureAtlas::Clear() {
+    pages.clear();
+    sprites.clear();
+    spriteIDs.clear();
+}
+
+int TextureAtlas::FindSprite(const std::string& name) const {
+    auto it = spriteIDs.find(name);
+    return it != spriteIDs.end() ? it->second : -1;
+}
+
+const AtlasSprite* TextureAtlas::GetSprite(int id) const {
+    if (id < 0 || id >= static_cast<int>(sprites.size())) return nullptr;
+    return &sprites[id];
+}
+
+// ============================================================================
+// GPU Timer Implementation
+// ============================================================================
+
+GpuPass GetLayerPass(RenderLayer layer) {
+    switch (layer) {
+        case RenderLayer::BACKGROUND: return GpuPass::BACKGROUND;
+        case RenderLayer::EFFECTS:    return GpuPass::PARTICLES;
+        case RenderLayer::HUD:
+        case RenderLayer::MENU:
+        case RenderLayer::DEBUG:      return GpuPass::UI;
+        default:                      return GpuPass::WORLD;
     }
-    if (quadEBO) {
-        glDeleteBuffers(1, &quadEBO);
-        quadEBO = 0;
+}
+
+GpuTimer::GpuTimer()
+    : currentPool(0)
+    , activePass(GpuPass::BACKGROUND)
+    , segmentOpen(false)
+    , initialized(false)
+    , hasResults(false)
+{
+    for (auto& pool : pools) {
+        std::memset(pool.queries, 0, sizeof(pool.queries));
+        pool.used = 0;
     }
-    if (particleVAO) {
-        glDeleteVertexArrays(1, &particleVAO);
-        particleVAO = 0;
+    for (double& ms : passMs) {
+        ms = 0.0;
     }
-    if (particleVBO) {
-        glDeleteBuffers(1, &particleVBO);
-        particleVBO = 0;
+}
+
+void GpuTimer::Initialize() {
+    for (auto& pool : pools) {
+        glGenQueries(MAX_SEGMENTS, pool.queries);
+        pool.used = 0;
     }
+    initialized = true;
 }
 
-void Renderer::InitQuadBuffers() {
-    // Quad vertices: position (2), texcoord (2), color (4)
-    float vertices[] = {
-        // Position      // TexCoord  // Color (white default)
-        -0.5f, -0.5f,    0.0f, 0.0f,  1.0f, 1.0f, 1.0f, 1.0f,
-         0.5f, -0.5f,    1.0f, 0.0f,  1.0f, 1.0f, 1.0f, 1.0f,
-         0.5f,  0.5f,    1.0f, 1.0f,  1.0f, 1.0f, 1.0f, 1.0f,
-        -0.5f,  0.5f,    0.0f, 1.0f,  1.0f, 1.0f, 1.0f, 1.0f
-    };
-    
-    unsigned int indices[] = {
-        0, 1, 2,
-        2, 3, 0
-    };
+void GpuTimer::Shutdown() {
+    if (!initialized) return;
     
-    glGenVertexArrays(1, &quadVAO);
-    glGenBuffers(1, &quadVBO);
-    glGenBuffers(1, &quadEBO);
+    EndSegment();
+    for (auto& pool : pools) {
+        glDeleteQueries(MAX_SEGMENTS, pool.queries);
+        pool.used = 0;
+    }
+    initialized = false;
+}
+
+bool GpuTimer::BeginFrame() {
+    if (!initialized) return false;
     
-    glBindVertexArray(quadVAO);
+    EndSegment();
     
-    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    // Recycle the oldest pool, harvesting its results if the GPU is done with them
+    currentPool = (currentPool + 1) % FRAME_BUFFERS;
+    bool resolved = ResolvePool(pools[currentPool]);
+    pools[currentPool].used = 0;
     
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    activePass = GpuPass::BACKGROUND;
+    BeginSegment();
+    return resolved;
+}
+
+void GpuTimer::EndFrame() {
+    if (!initialized) return;
+    EndSegment();
+}
+
+void GpuTimer::SetPass(GpuPass pass) {
+    if (pass == activePass && (segmentOpen || !initialized)) return;
     
-    // Position attribute
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    EndSegment();
+    activePass = pass;
+    if (initialized) {
+        BeginSegment();
+    }
+}
+
+const char* GpuTimer::GetPassName(GpuPass pass) {
+    switch (pass) {
+        case GpuPass::BACKGROUND: return "Background";
+        case GpuPass::WORLD:      return "World";
+        case GpuPass::PARTICLES:  return "Particles";
+        case GpuPass::UI:         return "UI/Text";
+        default:                  return "Unknown";
+    }
+}
+
+void GpuTimer::BeginSegment() {
+    QueryPool& pool = pools[currentPool];
+    if (pool.used >= MAX_SEGMENTS) return; // Out of queries; remaining work goes untimed
+    
+    pool.passes[pool.used] = activePass;
+    pool.submitTimes[pool.used] = g_Profiler.Now();
+    glBeginQuery(GL_TIME_ELAPSED, pool.queries[pool.used]);
+    segmentOpen = true;
+}
+
+void GpuTimer::EndSegment() {
+    if (!segmentOpen) return;
     
-    // TexCoord attribute
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    glEndQuery(GL_TIME_ELAPSED);
+    pools[currentPool].used++;
+    segmentOpen = false;
+}
+
+bool GpuTimer::ResolvePool(QueryPool& pool) {
+    if (pool.used == 0) return false;
+    
+    // Queries complete in order, so checking the last one is enough
+    GLint available = 0;
+    glGetQueryObjectiv(pool.queries[pool.used - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return false; // Never stall; drop this frame's timings instead
+    
+    double totals[static_cast<int>(GpuPass::COUNT)] = {};
+    double segmentMs[MAX_SEGMENTS];
+    double frameMs = 0.0;
+    for (int i = 0; i < pool.used; ++i) {
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(pool.queries[i], GL_QUERY_RESULT, &elapsed);
+        segmentMs[i] = elapsed / 1.0e6;
+        totals[static_cast<int>(pool.passes[i])] += segmentMs[i];
+        frameMs += segmentMs[i];
+    }
     
-    // Color attribute
-    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(4 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+    // Some drivers report garbage for the first query after context creation
+    if (frameMs > 1000.0) return false;
     
-    glBindVertexArray(0);
+    for (int i = 0; i < static_cast<int>(GpuPass::COUNT); ++i) {
+        passMs[i] = totals[i];
+    }
+    hasResults = true;
+    
+    // Only durations are known, so lay segments out back to back on the GPU
+    // track, none starting before the CPU issued it
+    if (g_Profiler.IsCapturing()) {
+        double gpuTime = 0.0;
+        for (int i = 0; i < pool.used; ++i) {
+            gpuTime = std::max(gpuTime, pool.submitTimes[i]);
+            g_Profiler.RecordGpuEvent(GetPassName(pool.passes[i]), gpuTime, segmentMs[i]);
+            gpuTime += segmentMs[i] / 1000.0;
+        }
+    }
+    return true;
 }
 
-void Renderer::InitParticleBuffers() {
-    particleVertices.reserve(MAX_PARTICLES_PER_BATCH * 6); // 6 vertices per particle (2 triangles)
+// ============================================================================
+// Stream Buffer Implementation
+// ============================================================================
+
+StreamBuffer::StreamBuffer()
+    : buffer(0)
+    , capacity(0)
+    , head(0)
+    , pendingBytes(0)
+    , frameBytes(0)
+    , mapped(nullptr)
+    , mappedFallback(false)
+    , firstFence(0)
+    , fenceCount(0)
+{
+}
+
+void StreamBuffer::Initialize(size_t capacityBytes) {
+    capacity = capacityBytes;
+    glGenBuffers(1, &buffer);
+    Orphan();
+}
+
+void StreamBuffer::Shutdown() {
+    if (!buffer) return;
     
-    glGenVertexArrays(1, &particleVAO);
-    glGenBuffers(1, &particleVBO);
+    if (mapped) {
+        Unmap(0);
+    }
+    for (int i = 0; i < fenceCount; ++i) {
+        glDeleteSync(fences[(firstFence + i) % MAX_FRAMES_IN_FLIGHT].fence);
+    }
+    fenceCount = 0;
+    glDeleteBuffers(1, &buffer);
+    buffer = 0;
+}
+
+void* StreamBuffer::Map(size_t maxBytes, size_t stride) {
+    if (mapped || maxBytes > capacity) return nullptr;
     
-    glBindVertexArray(particleVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, particleVBO);
-    glBufferData(GL_ARRAY_BUFFER, MAX_PARTICLES_PER_BATCH * 6 * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
+    RetireFrames();
     
-    // Position
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
-    glEnableVertexAttribArray(0);
+    // Align to the element size so draws can address the range by first vertex;
+    // a range that would run off the end starts over at zero
+    size_t start = (head + stride - 1) / stride * stride;
+    if (start + maxBytes > capacity) {
+        start = 0;
+    }
+    size_t skipped = start >= head ? start - head : capacity - head;
+    
+    // Reusing space the GPU may still read would mean waiting on a fence; give
+    // the driver a fresh store instead and start again from the beginning
+    if (pendingBytes + skipped + maxBytes > capacity) {
+        Orphan();
+        start = 0;
+        skipped = 0;
+    }
+    pendingBytes += skipped;
+    frameBytes += skipped;
+    head = start;
+    
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    mapped = glMapBufferRange(GL_COPY_WRITE_BUFFER, start, maxBytes,
+                              GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
+                              GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    
+    mappedFallback = mapped == nullptr;
+    if (mappedFallback) {
+        if (fallback.empty()) {
+            std::cerr << "glMapBufferRange failed; streaming through glBufferSubData" << std::endl;
+        }
+        if (fallback.size() < maxBytes) {
+            fallback.resize(maxBytes);
+        }
+        mapped = fallback.data();
+    }
+    return mapped;
+}
+
+size_t StreamBuffer::Unmap(size_t usedBytes) {
+    if (!mapped) return head;
     
-    // TexCoord
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
-    glEnableVertexAttribArray(1);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    if (mappedFallback) {
+        if (usedBytes > 0) {
+            glBufferSubData(GL_COPY_WRITE_BUFFER, head, usedBytes, fallback.data());
+        }
+    } else {
+        if (usedBytes > 0) {
+            glFlushMappedBufferRange(GL_COPY_WRITE_BUFFER, 0, usedBytes);
+        }
+        // GL_FALSE means the store was lost (mode switch); the next frame rewrites it anyway
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    mapped = nullptr;
+    
+    size_t offset = head;
+    head += usedBytes;
+    pendingBytes += usedBytes;
+    frameBytes += usedBytes;
+    if (usedBytes > 0) {
+        frameStats.bufferUploads++;
+        frameStats.bytesUploaded += usedBytes;
+    }
+    return offset;
+}
+
+void StreamBuffer::EndFrame() {
+    if (frameBytes == 0) return;
     
-    // Color
-    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
-    glEnableVertexAttribArray(2);
+    RetireFrames();
+    if (fenceCount == MAX_FRAMES_IN_FLIGHT) {
+        Orphan(); // Every fence is still pending; nothing in the ring is reusable
+        return;
+    }
     
-    glBindVertexArray(0);
+    FrameFence& entry = fences[(firstFence + fenceCount) % MAX_FRAMES_IN_FLIGHT];
+    entry.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    entry.bytes = frameBytes;
+    fenceCount++;
+    frameBytes = 0;
 }
 
-void Renderer::InitTextRendering() {
-    // Initialize FreeType library
-    if (FT_Init_FreeType(&ftLibrary)) {
-        std::cerr << "Could not initialize FreeType library" << std::endl;
-        fontInitialized = false;
-        return;
+void StreamBuffer::RetireFrames() {
+    // Fences signal in order; stop at the first frame the GPU has not finished
+    while (fenceCount > 0) {
+        FrameFence& entry = fences[firstFence];
+        GLenum status = glClientWaitSync(entry.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break;
+        
+        glDeleteSync(entry.fence);
+        pendingBytes -= entry.bytes;
+        firstFence = (firstFence + 1) % MAX_FRAMES_IN_FLIGHT;
+        fenceCount--;
     }
+}
+
+void StreamBuffer::Orphan() {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
     
-    // Try to load a default system font
-    // Common paths for different operating systems
+    for (int i = 0; i < fenceCount; ++i) {
+        glDeleteSync(fences[(firstFence + i) % MAX_FRAMES_IN_FLIGHT].fence);
+    }
+    firstFence = 0;
+    fenceCount = 0;
+    head = 0;
+    pendingBytes = 0;
+    frameBytes = 0;
+    frameStats.bufferOrphans++;
+}
+
+// ============================================================================
+// GPU Particles Implementation
+// ============================================================================
+
+GpuParticles::GpuParticles()
+    : spawnVAO(0)
+    , current(0)
+    , capacity(0)
+    , cursor(0)
+    , usedSlots(0)
+    , initialized(false)
+{
+    buffers[0] = buffers[1] = 0;
+    vertexArrays[0] = vertexArrays[1] = 0;
+}
+
+bool GpuParticles::Initialize(int slotCount) {
+    const std::vector<const char*> varyings = {
+        "outPosition", "outVelocity", "outAge", "outLifetime", "outDrag",
+        "outStartSize", "outEndSize", "outStartColor", "outEndColor"
+    };
+    if (!updateShader.LoadFeedbackFromFile("shaders/gpu_particle_update.glsl", varyings)) {
+        std::cerr << "Failed to load GPU particle update shader" << std::endl;
+        return false;
+    }
+    if (!renderShader.LoadFromFiles("shaders/gpu_particle_vertex.glsl", "shaders/particle_fragment.glsl")) {
+        std::cerr << "Failed to load GPU particle render shader" << std::endl;
+        return false;
+    }
+    renderShader.BindUniformBlock("Camera", CAMERA_BLOCK_BINDING);
+    
+    capacity = slotCount;
+    glGenBuffers(2, buffers);
+    glGenVertexArrays(2, vertexArrays);
+    for (int i = 0; i < 2; ++i) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[i]);
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(GpuParticle), nullptr, GL_DYNAMIC_COPY);
+        glBindVertexArray(vertexArrays[i]);
+        SetupAttributes(GPU_PARTICLE_LAYOUT, buffers[i]);
+    }
+    
+    spawnStream.Initialize(4 * MAX_SPAWNS_PER_STEP * sizeof(GpuParticle));
+    glGenVertexArrays(1, &spawnVAO);
+    glBindVertexArray(spawnVAO);
+    SetupAttributes(GPU_PARTICLE_LAYOUT, spawnStream.GetBuffer());
+    
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    Clear();
+    initialized = true;
+    return true;
+}
+
+void GpuParticles::Shutdown() {
+    if (!initialized) return;
+    
+    spawnStream.Shutdown();
+    glDeleteVertexArrays(1, &spawnVAO);
+    glDeleteVertexArrays(2, vertexArrays);
+    glDeleteBuffers(2, buffers);
+    spawnVAO = 0;
+    vertexArrays[0] = vertexArrays[1] = 0;
+    buffers[0] = buffers[1] = 0;
+    initialized = false;
+}
+
+void GpuParticles::Clear() {
+    // Slots past usedSlots are never read, so forgetting them is enough
+    cursor = 0;
+    usedSlots = 0;
+}
+
+void GpuParticles::Simulate(float deltaTime, const GpuParticle* spawns, int spawnCount) {
+    if (!initialized) return;
+    
+    spawnCount = std::min(spawnCount, std::min(capacity, static_cast<int>(MAX_SPAWNS_PER_STEP)));
+    if (usedSlots == 0 && spawnCount == 0) {
+        spawnStream.EndFrame();
+        return;
+    }
+    
+    size_t spawnOffset = 0;
+    if (spawnCount > 0) {
+        void* mapped = spawnStream.Map(spawnCount * sizeof(GpuParticle), sizeof(GpuParticle));
+        if (mapped) {
+            std::memcpy(mapped, spawns, spawnCount * sizeof(GpuParticle));
+            spawnOffset = spawnStream.Unmap(spawnCount * sizeof(GpuParticle));
+        } else {
+            spawnCount = 0;
+        }
+    }
+    
+    updateShader.Use();
+    glEnable(GL_RASTERIZER_DISCARD);
+    
+    // Every used slot of the other buffer is rewritten: spawns fill the ring
+    // from the cursor (wrapping), all other slots are advanced
+    int end = cursor + spawnCount;
+    if (end <= capacity) {
+        Advance(0, cursor, deltaTime);
+        Emit(cursor, spawnCount, spawnOffset, 0);
+        Advance(end, usedSlots - end, deltaTime);
+        usedSlots = std::max(usedSlots, end);
+    } else {
+        int wrapped = end - capacity;
+        Emit(0, wrapped, spawnOffset, capacity - cursor);
+        Advance(wrapped, cursor - wrapped, deltaTime);
+        Emit(cursor, capacity - cursor, spawnOffset, 0);
+        usedSlots = capacity;
+    }
+    cursor = end % capacity;
+    current = 1 - current;
+    
+    glDisable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(0);
+    spawnStream.EndFrame();
+}
+
+void GpuParticles::BeginCapture(int first, int count) {
+    GLuint target = buffers[1 - current];
+    glBindBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, 0, target,
+                      first * sizeof(GpuParticle), count * sizeof(GpuParticle));
+    glBeginTransformFeedback(GL_POINTS);
+}
+
+void GpuParticles::Advance(int first, int count, float deltaTime) {
+    if (count <= 0) return;
+    
+    updateShader.SetFloat(U_DELTA_TIME, deltaTime);
+    glBindVertexArray(vertexArrays[current]);
+    BeginCapture(first, count);
+    glDrawArrays(GL_POINTS, first, count);
+    glEndTransformFeedback();
+    frameStats.drawCalls++;
+    frameStats.vertices += count;
+}
+
+void GpuParticles::Emit(int first, int count, size_t spawnOffset, int spawnIndex) {
+    if (count <= 0) return;
+    
+    // Spawns pass through the update shader unchanged (zero step)
+    updateShader.SetFloat(U_DELTA_TIME, 0.0f);
+    glBindVertexArray(spawnVAO);
+    PointAttributes(GPU_PARTICLE_LAYOUT, spawnStream.GetBuffer(), spawnOffset);
+    BeginCapture(first, count);
+    glDrawArrays(GL_POINTS, spawnIndex, count);
+    glEndTransformFeedback();
+    frameStats.drawCalls++;
+    frameStats.vertices += count;
+}
+
+void GpuParticles::Draw() {
+    if (!initialized || usedSlots == 0) return;
+    
+    // Free slots are still drawn; the vertex shader moves them out of view
+    renderShader.Use();
+    glBindVertexArray(vertexArrays[current]);
+    glDrawArrays(GL_POINTS, 0, usedSlots);
+    glBindVertexArray(0);
+    frameStats.drawCalls++;
+    frameStats.vertices += usedSlots;
+}
+
+// ============================================================================
+// Text Label Implementation
+// ============================================================================
+
+bool TextLabel::Changed(long long value) {
+    if (hasValue && value == boundValue) return false;
+    
+    boundValue = value;
+    hasValue = true;
+    return true;
+}
+
+void TextLabel::SetText(IRenderer& renderer, const std::string& text, float scale) {
+    layout = renderer.LayoutText(text, scale);
+}
+
+void TextLabel::Draw(IRenderer& renderer, const glm::vec2& position, const glm::vec4& color) const {
+    if (layout) {
+        renderer.DrawText(*layout, position, color);
+    }
+}
+
+const std::string& TextLabel::GetText() const {
+    static const std::string empty;
+    return layout ? layout->text : empty;
+}
+
+// ============================================================================
+// Renderer Interface Implementation
+// ============================================================================
+
+IRenderer::IRenderer()
+    : windowWidth(0), windowHeight(0)
+    , cameraPosition(0.0f)
+    , cameraShakeOffset(0.0f)
+    , shakeIntensity(0.0f)
+    , shakeDuration(0.0f)
+    , shakeTimer(0.0f)
+    , cameraDirty(true)
+    , layer(RenderLayer::BACKGROUND)
+    , layerDepth(0)
+    , blendMode(BlendMode::ALPHA)
+    , visibleObjects(0), culledObjects(0)
+    , lastVisibleObjects(0), lastCulledObjects(0)
+{
+}
+
+void IRenderer::BeginFrame() {
+    visibleObjects = 0;
+    culledObjects = 0;
+    layer = RenderLayer::BACKGROUND;
+    layerDepth = 0;
+    blendMode = BlendMode::ALPHA;
+}
+
+void IRenderer::EndFrame() {
+    lastVisibleObjects = visibleObjects;
+    lastCulledObjects = culledObjects;
+}
+
+RenderStats IRenderer::GetStats() const {
+    RenderStats stats;
+    stats.visibleObjects = lastVisibleObjects;
+    stats.culledObjects = lastCulledObjects;
+    return stats;
+}
+
+void IRenderer::SetLayer(RenderLayer newLayer, uint16_t depth) {
+    layer = newLayer;
+    layerDepth = depth;
+}
+
+void IRenderer::SetCameraPosition(const glm::vec2& position) {
+    if (position == cameraPosition) return;
+    
+    cameraPosition = position;
+    cameraDirty = true;
+}
+
+glm::vec2 IRenderer::ScreenToWorld(const glm::vec2& screenPos) const {
+    glm::vec2 centered = screenPos - glm::vec2(windowWidth * 0.5f, windowHeight * 0.5f);
+    return centered + cameraPosition;
+}
+
+glm::vec2 IRenderer::WorldToScreen(const glm::vec2& worldPos) const {
+    glm::vec2 relative = worldPos - cameraPosition;
+    return relative + glm::vec2(windowWidth * 0.5f, windowHeight * 0.5f);
+}
+
+bool IRenderer::IsVisible(const glm::vec2& center, float radius) {
+    // The view matrix subtracts the shake offset, so the visible rect moves the other way
+    glm::vec2 viewCenter = cameraPosition - cameraShakeOffset;
+    float halfWidth = windowWidth * 0.5f + radius;
+    float halfHeight = windowHeight * 0.5f + radius;
+    
+    bool visible = std::abs(center.x - viewCenter.x) <= halfWidth &&
+                   std::abs(center.y - viewCenter.y) <= halfHeight;
+    if (visible) {
+        visibleObjects++;
+    } else {
+        culledObjects++;
+    }
+    return visible;
+}
+
+glm::mat4 IRenderer::GetProjectionMatrix() const {
+    return glm::ortho(0.0f, (float)windowWidth, (float)windowHeight, 0.0f, -1.0f, 1.0f);
+}
+
+glm::mat4 IRenderer::GetViewMatrix() const {
+    glm::mat4 view = glm::mat4(1.0f);
+    view = glm::translate(view, glm::vec3(windowWidth * 0.5f, windowHeight * 0.5f, 0.0f));
+    view = glm::translate(view, glm::vec3(-cameraPosition.x + cameraShakeOffset.x, 
+                                          -cameraPosition.y + cameraShakeOffset.y, 0.0f));
+    return view;
+}
+
+void IRenderer::SetScreenShake(float intensity, float duration) {
+    shakeIntensity = intensity;
+    shakeDuration = duration;
+    shakeTimer = 0.0f;
+}
+
+void IRenderer::UpdateScreenShake(float deltaTime) {
+    if (shakeDuration <= 0.0f) {
+        if (cameraShakeOffset != glm::vec2(0.0f)) {
+            cameraShakeOffset = glm::vec2(0.0f);
+            cameraDirty = true;
+        }
+        return;
+    }
+    
+    cameraDirty = true;
+    shakeTimer += deltaTime;
+    if (shakeTimer >= shakeDuration) {
+        shakeDuration = 0.0f;
+        cameraShakeOffset = glm::vec2(0.0f);
+        return;
+    }
+    
+    // Calculate shake with decay
+    float decay = 1.0f - (shakeTimer / shakeDuration);
+    float currentIntensity = shakeIntensity * decay;
+    
+    cameraShakeOffset = glm::vec2(
+        Utils::RandomFloat(-currentIntensity, currentIntensity),
+        Utils::RandomFloat(-currentIntensity, currentIntensity)
+    );
+}
+
+// ============================================================================
+// Renderer Implementation
+// ============================================================================
+
+Renderer::Renderer()
+    : cameraUBO(0)
+    , cameraUploadPending(false)
+    , quadVAO(0), quadVBO(0), quadEBO(0)
+    , spriteBatchVAO(0)
+    , spriteWrite(nullptr), spriteCount(0)
+    , spriteBatchTexture(nullptr)
+    , shapeVAO(0)
+    , shapeWrite(nullptr), shapeCount(0)
+    , prefabVAO(0), prefabVBO(0)
+    , prefabWrite(nullptr), prefabCount(0)
+    , prefabBatchPrefab(-1)
+    , uiVAO(0)
+    , uiWrite(nullptr), uiCount(0)
+    , particleVAO(0)
+    , particleWrite(nullptr), particleCount(0)
+    , textVAO(0)
+    , textWrite(nullptr), textVertexCount(0)
+    , frameIndex(0)
+    , starVAO(0), starVBO(0)
+    , starCount(0)
+    , ftLibrary(nullptr)
+    , ftFace(nullptr)
+    , fontInitialized(false)
+    , recorder(nullptr)
+    , submittedBlend(BlendMode::ALPHA)
+{
+    for (Character& ch : characters) {
+        ch.loaded = false;
+    }
+}
+
+Renderer::~Renderer() {
+    Shutdown();
+}
+
+bool Renderer::Initialize(int width, int height) {
+    windowWidth = width;
+    windowHeight = height;
+    
+    // Print OpenGL info
+    std::cout << "OpenGL Renderer: " << glGetString(GL_RENDERER) << std::endl;
+    std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
+    
+    // Set up OpenGL state
+    glViewport(0, 0, windowWidth, windowHeight);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_PROGRAM_POINT_SIZE);    // Point sprites size themselves in the vertex shader
+    
+    // Load shaders from files
+    if (!spriteShader.LoadFromFiles("shaders/vertex.glsl", "shaders/fragment.glsl")) {
+        std::cerr << "Failed to load sprite shader" << std::endl;
+        return false;
+    }
+    
+    if (!spriteBatchShader.LoadFromFiles("shaders/sprite_vertex.glsl", "shaders/sprite_fragment.glsl")) {
+        std::cerr << "Failed to load sprite batch shader" << std::endl;
+        return false;
+    }
+    
+    if (!shapeShader.LoadFromFiles("shaders/shape_vertex.glsl", "shaders/shape_fragment.glsl")) {
+        std::cerr << "Failed to load shape shader" << std::endl;
+        return false;
+    }
+    
+    if (!prefabShader.LoadFromFiles("shaders/prefab_vertex.glsl", "shaders/color_fragment.glsl")) {
+        std::cerr << "Failed to load prefab shader" << std::endl;
+        return false;
+    }
+    
+    if (!uiShader.LoadFromFiles("shaders/ui_vertex.glsl", "shaders/color_fragment.glsl")) {
+        std::cerr << "Failed to load UI shader" << std::endl;
+        return false;
+    }
+    
+    if (!starfieldShader.LoadFromFiles("shaders/starfield_vertex.glsl", "shaders/starfield_fragment.glsl")) {
+        std::cerr << "Failed to load starfield shader" << std::endl;
+        return false;
+    }
+    
+    if (!particleShader.LoadFromFiles("shaders/particle_vertex.glsl", "shaders/particle_fragment.glsl")) {
+        std::cerr << "Failed to load particle shader" << std::endl;
+        return false;
+    }
+    
+    if (!textShader.LoadFromFiles("shaders/text_vertex.glsl", "shaders/text_fragment.glsl")) {
+        std::cerr << "Failed to load text shader" << std::endl;
+        return false;
+    }
+    
+    // Shared camera block; the samplers and the particle model matrix never
+    // change, so set them once here instead of per draw
+    InitCameraBlock();
+    for (Shader* shader : { &spriteShader, &spriteBatchShader, &shapeShader, &prefabShader, &uiShader, &starfieldShader, &particleShader, &textShader }) {
+        shader->BindUniformBlock("Camera", CAMERA_BLOCK_BINDING);
+    }
+    spriteShader.Use();
+    spriteShader.SetMat4(U_MODEL, glm::mat4(1.0f));
+    spriteShader.SetInt(U_USE_TEXTURE, 0);
+    spriteShader.SetInt(U_TEXTURE_SAMPLER, 0);
+    spriteBatchShader.Use();
+    spriteBatchShader.SetInt(U_TEXTURE_SAMPLER, 0);
+    textShader.Use();
+    textShader.SetInt(U_TEXT_SAMPLER, 0);
+    starfieldShader.Use();
+    starfieldShader.SetVec2(U_VIEWPORT_SIZE, glm::vec2(windowWidth, windowHeight));
+    glUseProgram(0);
+    
+    // Initialize buffers
+    InitQuadBuffers();
+    InitSpriteBatch();
+    InitShapeBatch();
+    InitPrefabBatch();
+    InitUiBatch();
+    InitParticleBuffers();
+    
+    // Create white texture for solid color rendering
+    whiteTexture.CreateSolid(4, 4, Colors::WHITE);
+    
+    // Initialize starfield
+    InitStarfield(GetStarCountForResolution(windowWidth, windowHeight), GetDefaultStarLayers());
+    
+    // Initialize text rendering
+    InitTextRendering();
+    
+    // GPU pass timing
+    gpuTimer.Initialize();
+    
+    return true;
+}
+
+void Renderer::Shutdown() {
+    StopRenderThread();
+    gpuTimer.Shutdown();
+    gpuParticles.Shutdown();
+    
+    if (cameraUBO) {
+        glDeleteBuffers(1, &cameraUBO);
+        cameraUBO = 0;
+    }
+    
+    // Clean up text rendering resources
+    if (textVAO) {
+        glDeleteVertexArrays(1, &textVAO);
+        textVAO = 0;
+    }
+    textStream.Shutdown();
+    textWrite = nullptr;
+    textVertexCount = 0;
+    
+    // Font glyphs live in fontAtlas, which is released with the renderer
+    for (Character& ch : characters) {
+        ch.loaded = false;
+    }
+    
+    // Clean up FreeType resources
+    if (ftFace) {
+        FT_Done_Face(ftFace);
+        ftFace = nullptr;
+    }
+    if (ftLibrary) {
+        FT_Done_FreeType(ftLibrary);
+        ftLibrary = nullptr;
+    }
+    
+    if (quadVAO) {
+        glDeleteVertexArrays(1, &quadVAO);
+        quadVAO = 0;
+    }
+    if (quadVBO) {
+        glDeleteBuffers(1, &quadVBO);
+        quadVBO = 0;
+    }
+    if (quadEBO) {
+        glDeleteBuffers(1, &quadEBO);
+        quadEBO = 0;
+    }
+    if (spriteBatchVAO) {
+        glDeleteVertexArrays(1, &spriteBatchVAO);
+        spriteBatchVAO = 0;
+    }
+    spriteStream.Shutdown();
+    spriteWrite = nullptr;
+    spriteCount = 0;
+    if (shapeVAO) {
+        glDeleteVertexArrays(1, &shapeVAO);
+        shapeVAO = 0;
+    }
+    shapeStream.Shutdown();
+    shapeWrite = nullptr;
+    shapeCount = 0;
+    if (prefabVAO) {
+        glDeleteVertexArrays(1, &prefabVAO);
+        prefabVAO = 0;
+    }
+    if (prefabVBO) {
+        glDeleteBuffers(1, &prefabVBO);
+        prefabVBO = 0;
+    }
+    prefabStream.Shutdown();
+    prefabWrite = nullptr;
+    prefabCount = 0;
+    prefabBatchPrefab = -1;
+    prefabs.clear();
+    prefabVertices.clear();
+    if (uiVAO) {
+        glDeleteVertexArrays(1, &uiVAO);
+        uiVAO = 0;
+    }
+    uiStream.Shutdown();
+    uiWrite = nullptr;
+    uiCount = 0;
+    if (starVAO) {
+        glDeleteVertexArrays(1, &starVAO);
+        starVAO = 0;
+    }
+    if (starVBO) {
+        glDeleteBuffers(1, &starVBO);
+        starVBO = 0;
+    }
+    if (particleVAO) {
+        glDeleteVertexArrays(1, &particleVAO);
+        particleVAO = 0;
+    }
+    particleStream.Shutdown();
+    particleWrite = nullptr;
+    particleCount = 0;
+    
+    spriteAtlas.Clear();
+}
+
+void Renderer::InitQuadBuffers() {
+    // Unit quad with texcoords and a white default color
+    const Vertex vertices[] = {
+        Vertex(glm::vec2(-0.5f, -0.5f), glm::vec2(0.0f, 0.0f), Colors::WHITE),
+        Vertex(glm::vec2( 0.5f, -0.5f), glm::vec2(1.0f, 0.0f), Colors::WHITE),
+        Vertex(glm::vec2( 0.5f,  0.5f), glm::vec2(1.0f, 1.0f), Colors::WHITE),
+        Vertex(glm::vec2(-0.5f,  0.5f), glm::vec2(0.0f, 1.0f), Colors::WHITE)
+    };
+    
+    unsigned int indices[] = {
+        0, 1, 2,
+        2, 3, 0
+    };
+    
+    glGenVertexArrays(1, &quadVAO);
+    glGenBuffers(1, &quadVBO);
+    glGenBuffers(1, &quadEBO);
+    
+    glBindVertexArray(quadVAO);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    
+    SetupAttributes(QUAD_LAYOUT, quadVBO);
+    
+    glBindVertexArray(0);
+}
+
+void Renderer::InitCameraBlock() {
+    glGenBuffers(1, &cameraUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(RenderCamera), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BLOCK_BINDING, cameraUBO);
+    cameraDirty = true;
+}
+
+void Renderer::UpdateCameraBlock() {
+    if (!cameraUploadPending) return;
+    
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(submittedCamera), &submittedCamera);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    frameStats.bufferUploads++;
+    frameStats.bytesUploaded += sizeof(submittedCamera);
+    cameraUploadPending = false;
+}
+
+void Renderer::SyncCamera() {
+    // Called before each draw so a camera change lands between the right draws
+    if (!cameraDirty) return;
+    
+    RenderCamera camera;
+    camera.projection = GetProjectionMatrix();
+    camera.view = GetViewMatrix();
+    if (recorder) {
+        recorder->SetCamera(camera);
+    } else {
+        SubmitCamera(camera);
+    }
+    cameraDirty = false;
+}
+
+uint64_t Renderer::MakeSortKey(int program, const Texture* texture) const {
+    return SortKey::Make(layer, blendMode, program, texture ? texture->textureID : 0, layerDepth);
+}
+
+void Renderer::SubmitCamera(const RenderCamera& camera) {
+    DrawSpriteBatch(); // Queued world sprites, shapes and prefabs were placed with the old camera
+    DrawShapeBatch();
+    DrawPrefabBatch();
+    submittedCamera = camera;
+    cameraUploadPending = true;
+}
+
+void Renderer::InitSpriteBatch() {
+    spriteStream.Initialize(STREAM_BATCHES * MAX_SPRITES_PER_BATCH * sizeof(SpriteInstance));
+    
+    glGenVertexArrays(1, &spriteBatchVAO);
+    glBindVertexArray(spriteBatchVAO);
+    
+    // Per-vertex: corners of the static unit quad
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
+    SetupAttributes(QUAD_CORNER_LAYOUT, quadVBO);
+    
+    // Per-instance: transform, UV rect, color, rotation, flags (re-pointed at each batch's range)
+    SetupAttributes(SPRITE_LAYOUT, spriteStream.GetBuffer());
+    
+    glBindVertexArray(0);
+}
+
+void Renderer::PointSpriteInstances(size_t offset) {
+    // GL 3.3 has no base instance, so each batch moves the attributes to its range
+    PointAttributes(SPRITE_LAYOUT, spriteStream.GetBuffer(), offset);
+}
+
+void Renderer::InitShapeBatch() {
+    shapeStream.Initialize(STREAM_BATCHES * MAX_SHAPES_PER_BATCH * sizeof(ShapeInstance));
+    
+    glGenVertexArrays(1, &shapeVAO);
+    glBindVertexArray(shapeVAO);
+    
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
+    SetupAttributes(QUAD_CORNER_LAYOUT, quadVBO);
+    SetupAttributes(SHAPE_LAYOUT, shapeStream.GetBuffer());
+    
+    glBindVertexArray(0);
+}
+
+void Renderer::InitPrefabBatch() {
+    prefabStream.Initialize(STREAM_BATCHES * MAX_PREFABS_PER_BATCH * sizeof(PrefabInstance));
+    glGenBuffers(1, &prefabVBO);
+    
+    glGenVertexArrays(1, &prefabVAO);
+    glBindVertexArray(prefabVAO);
+    
+    // Per-vertex: every prefab's parts, filled in by CreatePrefab
+    SetupAttributes(PREFAB_MESH_LAYOUT, prefabVBO);
+    
+    // Per-instance: transform and tint (re-pointed at each batch's range)
+    SetupAttributes(PREFAB_INSTANCE_LAYOUT, prefabStream.GetBuffer());
+    
+    glBindVertexArray(0);
+}
+
+void Renderer::InitUiBatch() {
+    uiStream.Initialize(STREAM_BATCHES * MAX_UI_RECTS_PER_BATCH * sizeof(UiRect));
+    
+    glGenVertexArrays(1, &uiVAO);
+    glBindVertexArray(uiVAO);
+    
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
+    SetupAttributes(QUAD_CORNER_LAYOUT, quadVBO);
+    SetupAttributes(UI_RECT_LAYOUT, uiStream.GetBuffer());
+    
+    glBindVertexArray(0);
+}
+
+void Renderer::InitParticleBuffers() {
+    // One point sprite per particle
+    particleStream.Initialize(STREAM_BATCHES * MAX_PARTICLES_PER_BATCH * sizeof(ParticleVertex));
+    
+    glGenVertexArrays(1, &particleVAO);
+    glBindVertexArray(particleVAO);
+    SetupAttributes(PARTICLE_LAYOUT, particleStream.GetBuffer());
+    glBindVertexArray(0);
+}
+
+void Renderer::InitTextRendering() {
+    // Initialize FreeType library
+    if (FT_Init_FreeType(&ftLibrary)) {
+        std::cerr << "Could not initialize FreeType library" << std::endl;
+        fontInitialized = false;
+        return;
+    }
+    
+    // Try to load a default system font
+    // Common paths for different operating systems
     std::vector<std::string> fontPaths = {
         "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",           // Linux
         "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf", // Linux
@@ -411,231 +1697,551 @@ void Renderer::InitTextRendering() {
     }
     
     // Set font size (48 pixels height)
-    FT_Set_Pixel_Sizes(ftFace, 0, 48);
+    FT_Set_Pixel_Sizes(ftFace, 0, FONT_PIXEL_SIZE);
     
     // Disable byte-alignment restriction
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     
-    // Load first 128 ASCII characters
-    for (unsigned char c = 0; c < 128; c++) {
+    // Rasterize the first 128 ASCII characters into shelves of one atlas
+    std::vector<unsigned char> atlas(FONT_ATLAS_WIDTH * FONT_ATLAS_MAX_HEIGHT, 0);
+    glm::ivec2 atlasPos[FONT_GLYPH_COUNT];
+    int penX = FONT_ATLAS_PADDING;
+    int penY = FONT_ATLAS_PADDING;
+    int shelfHeight = 0;
+    
+    for (unsigned char c = 0; c < FONT_GLYPH_COUNT; c++) {
         // Load character glyph
         if (FT_Load_Char(ftFace, c, FT_LOAD_RENDER)) {
             std::cerr << "Failed to load glyph for character: " << c << std::endl;
             continue;
         }
         
-        // Generate texture
-        GLuint texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            ftFace->glyph->bitmap.width,
-            ftFace->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            ftFace->glyph->bitmap.buffer
-        );
+        const FT_Bitmap& bitmap = ftFace->glyph->bitmap;
+        int w = static_cast<int>(bitmap.width);
+        int h = static_cast<int>(bitmap.rows);
+        
+        // Start a new shelf when this row is full
+        if (penX + w + FONT_ATLAS_PADDING > FONT_ATLAS_WIDTH) {
+            penX = FONT_ATLAS_PADDING;
+            penY += shelfHeight + FONT_ATLAS_PADDING;
+            shelfHeight = 0;
+        }
+        if (penY + h + FONT_ATLAS_PADDING > FONT_ATLAS_MAX_HEIGHT) {
+            std::cerr << "Font atlas full; skipping character: " << c << std::endl;
+            continue;
+        }
+        
+        for (int row = 0; row < h; ++row) {
+            std::memcpy(&atlas[(penY + row) * FONT_ATLAS_WIDTH + penX],
+                        bitmap.buffer + row * bitmap.pitch, w);
+        }
         
-        // Set texture options
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        // Store character for later use (UVs are filled in once the atlas height is known)
+        Character& character = characters[c];
+        character.size = glm::ivec2(w, h);
+        character.bearing = glm::ivec2(ftFace->glyph->bitmap_left, ftFace->glyph->bitmap_top);
+        character.advance = static_cast<unsigned int>(ftFace->glyph->advance.x);
+        character.loaded = true;
+        atlasPos[c] = glm::ivec2(penX, penY);
         
-        // Store character for later use
-        Character character = {
-            texture,
-            glm::ivec2(ftFace->glyph->bitmap.width, ftFace->glyph->bitmap.rows),
-            glm::ivec2(ftFace->glyph->bitmap_left, ftFace->glyph->bitmap_top),
-            static_cast<unsigned int>(ftFace->glyph->advance.x)
-        };
-        characters.insert(std::pair<char, Character>(c, character));
+        penX += w + FONT_ATLAS_PADDING;
+        shelfHeight = std::max(shelfHeight, h);
     }
     
-    glBindTexture(GL_TEXTURE_2D, 0);
+    // Upload only the rows in use, rounded up to a power of two
+    int atlasHeight = 1;
+    while (atlasHeight < penY + shelfHeight + FONT_ATLAS_PADDING) {
+        atlasHeight *= 2;
+    }
+    fontAtlas.CreateFromData(atlas.data(), FONT_ATLAS_WIDTH, atlasHeight, 1);
+    
+    for (int c = 0; c < FONT_GLYPH_COUNT; ++c) {
+        Character& character = characters[c];
+        if (!character.loaded) continue;
+        glm::vec2 topLeft(atlasPos[c]);
+        glm::vec2 bottomRight = topLeft + glm::vec2(character.size);
+        character.uvRect = glm::vec4(topLeft.x / FONT_ATLAS_WIDTH, topLeft.y / atlasHeight,
+                                     bottomRight.x / FONT_ATLAS_WIDTH, bottomRight.y / atlasHeight);
+    }
     
-    // Configure VAO/VBO for texture quads
+    // Configure VAO/VBO for batched glyph quads
+    textStream.Initialize(STREAM_BATCHES * MAX_GLYPHS_PER_BATCH * 6 * sizeof(TextVertex));
     glGenVertexArrays(1, &textVAO);
-    glGenBuffers(1, &textVBO);
     glBindVertexArray(textVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, textVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
+    SetupAttributes(TEXT_LAYOUT, textStream.GetBuffer());
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
     
-    fontInitialized = true;
-    std::cout << "Text rendering initialized successfully" << std::endl;
+    fontInitialized = true;
+    std::cout << "Text rendering initialized successfully" << std::endl;
+}
+
+int Renderer::GetStarCountForResolution(int width, int height) {
+    // Keep the on-screen density constant whatever the window size
+    float area = static_cast<float>(width) * height;
+    return static_cast<int>(STARS_AT_REFERENCE_RESOLUTION * area / (1280.0f * 720.0f));
+}
+
+std::vector<StarLayer> Renderer::GetDefaultStarLayers() {
+    return {
+        //        parallax  share  size        brightness
+        StarLayer(0.15f,    0.55f, 1.0f, 1.5f, 0.2f, 0.5f),   // Distant dust
+        StarLayer(0.4f,     0.30f, 1.0f, 2.5f, 0.3f, 0.8f),
+        StarLayer(1.0f,     0.15f, 1.5f, 3.0f, 0.5f, 1.0f)    // Moves with the world
+    };
+}
+
+void Renderer::InitStarfield(int count, const std::vector<StarLayer>& layers) {
+    std::vector<Star> stars;
+    stars.reserve(count);
+    
+    float totalShare = 0.0f;
+    for (const StarLayer& layer : layers) {
+        totalShare += layer.share;
+    }
+    
+    for (size_t l = 0; l < layers.size(); ++l) {
+        const StarLayer& layer = layers[l];
+        // The last layer takes the rounding remainder
+        int layerCount = (l + 1 == layers.size()) ? count - static_cast<int>(stars.size())
+                                                  : static_cast<int>(count * layer.share / totalShare);
+        for (int i = 0; i < layerCount; ++i) {
+            Star star;
+            star.position = glm::vec2(Utils::RandomFloat(0.0f, static_cast<float>(windowWidth)),
+                                      Utils::RandomFloat(0.0f, static_cast<float>(windowHeight)));
+            star.size = Utils::RandomFloat(layer.minSize, layer.maxSize);
+            star.brightness = Utils::RandomFloat(layer.minBrightness, layer.maxBrightness);
+            star.twinkleSpeed = Utils::RandomFloat(1.0f, 3.0f);
+            star.twinklePhase = Utils::RandomFloat(0.0f, glm::two_pi<float>());
+            star.parallax = layer.parallax;
+            stars.push_back(star);
+        }
+    }
+    starCount = static_cast<int>(stars.size());
+    
+    if (!starVAO) {
+        glGenVertexArrays(1, &starVAO);
+        glGenBuffers(1, &starVBO);
+        
+        glBindVertexArray(starVAO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
+        SetupAttributes(QUAD_CORNER_LAYOUT, quadVBO);
+        SetupAttributes(STAR_LAYOUT, starVBO);
+        glBindVertexArray(0);
+    }
+    
+    // Written once; nothing about the stars changes per frame
+    glBindBuffer(GL_ARRAY_BUFFER, starVBO);
+    glBufferData(GL_ARRAY_BUFFER, stars.size() * sizeof(Star), stars.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Renderer::StartRenderThread(GLFWwindow* window) {
+    if (renderThread) return;
+    
+    renderThread.reset(new RenderThread());
+    renderThread->Start(this, window);
+    std::cout << "Rendering on a separate thread" << std::endl;
+}
+
+void Renderer::StopRenderThread() {
+    if (!renderThread) return;
+    
+    // Drop a frame left half-recorded; everything submitted is still drawn
+    recorder = nullptr;
+    renderThread->Stop();
+    renderThread.reset();
+}
+
+void Renderer::BeginFrame() {
+    IRenderer::BeginFrame();
+    clipRects.clear();
+    
+    if (renderThread) {
+        recorder = renderThread->BeginFrame();
+    } else {
+        if (!frameCommands) {
+            frameCommands.reset(new RenderCommandBuffer());
+        }
+        frameCommands->Clear();
+        recorder = frameCommands.get();
+    }
+    SyncCamera();
 }
 
-void Renderer::InitStarfield(int starCount) {
-    stars.clear();
-    stars.reserve(starCount);
+void Renderer::EndFrame() {
+    if (recorder) {
+        {
+            PROFILE_ZONE("Sort Draws");
+            recorder->Sort();
+        }
+        if (renderThread) {
+            renderThread->EndFrame();
+        } else {
+            BeginSubmission();
+            recorder->Replay(*this);
+            EndSubmission();
+        }
+        recorder = nullptr;
+    }
+    IRenderer::EndFrame();
     
-    for (int i = 0; i < starCount; ++i) {
-        Star star;
-        star.position = glm::vec2(
-            Utils::RandomFloat(-Constants::WORLD_WIDTH, Constants::WORLD_WIDTH * 2),
-            Utils::RandomFloat(-Constants::WORLD_HEIGHT, Constants::WORLD_HEIGHT * 2)
-        );
-        star.size = Utils::RandomFloat(1.0f, 3.0f);
-        star.brightness = Utils::RandomFloat(0.3f, 1.0f);
-        star.twinkleSpeed = Utils::RandomFloat(1.0f, 3.0f);
-        star.twinklePhase = Utils::RandomFloat(0.0f, glm::two_pi<float>());
-        stars.push_back(star);
+    frameIndex++;
+    if (frameIndex % 60 == 0) {
+        EvictTextLayouts();
     }
 }
 
-void Renderer::BeginFrame() {
+void Renderer::BeginSubmission() {
+    // Publish the GPU timings that finished since the last time this pool was used
+    if (gpuTimer.BeginFrame()) {
+        for (int i = 0; i < static_cast<int>(GpuPass::COUNT); ++i) {
+            GpuPass pass = static_cast<GpuPass>(i);
+            g_Profiler.ReportGpuTime(GpuTimer::GetPassName(pass), gpuTimer.GetPassMs(pass));
+        }
+    }
+    
+    frameStats = RenderStats();
+    UpdateCameraBlock();
+    SubmitBlendMode(BlendMode::ALPHA);
+    
     glClearColor(0.01f, 0.01f, 0.04f, 1.0f); // Dark space blue
     glClear(GL_COLOR_BUFFER_BIT);
 }
 
-void Renderer::EndFrame() {
-    // Flush any remaining particles
-    FlushParticles();
+void Renderer::EndSubmission() {
+    // Flush any remaining sprites, shapes, prefabs, UI rects, text and particles
+    DrawSpriteBatch();
+    DrawShapeBatch();
+    DrawPrefabBatch();
+    DrawUiBatch();
+    DrawTextBatch();
+    DrawParticleBatch();
+    spriteStream.EndFrame();
+    shapeStream.EndFrame();
+    prefabStream.EndFrame();
+    uiStream.EndFrame();
+    textStream.EndFrame();
+    particleStream.EndFrame();
+    
+    gpuTimer.EndFrame();
+    std::lock_guard<std::mutex> lock(statsMutex);
+    lastFrameStats = frameStats;
 }
 
-void Renderer::SetCameraPosition(const glm::vec2& position) {
-    cameraPosition = position;
+RenderStats Renderer::GetStats() const {
+    RenderStats stats;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats = lastFrameStats;
+    }
+    stats.visibleObjects = lastVisibleObjects;
+    stats.culledObjects = lastCulledObjects;
+    return stats;
 }
 
-glm::vec2 Renderer::ScreenToWorld(const glm::vec2& screenPos) const {
-    glm::vec2 centered = screenPos - glm::vec2(windowWidth * 0.5f, windowHeight * 0.5f);
-    return centered + cameraPosition;
+void Renderer::DrawSprite(const glm::vec2& position, const glm::vec2& size, float rotation,
+                         const glm::vec4& color, Texture* texture) {
+    QueueSprite(position, size, rotation, color, texture, FULL_UV_RECT, false, true);
 }
 
-glm::vec2 Renderer::WorldToScreen(const glm::vec2& worldPos) const {
-    glm::vec2 relative = worldPos - cameraPosition;
-    return relative + glm::vec2(windowWidth * 0.5f, windowHeight * 0.5f);
+void Renderer::DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
+                              const glm::vec4& color, Texture* texture) {
+    QueueSprite(position, size, rotation, color, texture, FULL_UV_RECT, false, false);
 }
 
-glm::mat4 Renderer::GetProjectionMatrix() const {
-    return glm::ortho(0.0f, (float)windowWidth, (float)windowHeight, 0.0f, -1.0f, 1.0f);
+void Renderer::DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
+                              const glm::vec4& color, Texture* texture, bool flipHorizontal) {
+    QueueSprite(position, size, rotation, color, texture, FULL_UV_RECT, flipHorizontal, false);
 }
 
-glm::mat4 Renderer::GetViewMatrix() const {
-    glm::mat4 view = glm::mat4(1.0f);
-    view = glm::translate(view, glm::vec3(windowWidth * 0.5f, windowHeight * 0.5f, 0.0f));
-    view = glm::translate(view, glm::vec3(-cameraPosition.x + cameraShakeOffset.x, 
-                                          -cameraPosition.y + cameraShakeOffset.y, 0.0f));
-    return view;
+bool Renderer::LoadSpriteAtlas(const std::string& directory) {
+    return spriteAtlas.LoadDirectory(directory);
 }
 
-void Renderer::DrawSprite(const glm::vec2& position, const glm::vec2& size, float rotation,
-                         const glm::vec4& color, Texture* texture) {
-    spriteShader.Use();
-    
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(position, 0.0f));
-    model = glm::rotate(model, rotation, glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::scale(model, glm::vec3(size, 1.0f));
-    
-    glm::mat4 projection = GetProjectionMatrix();
-    glm::mat4 view = glm::mat4(1.0f); // Screen space
-    
-    spriteShader.SetMat4("projection", projection);
-    spriteShader.SetMat4("view", view);
-    spriteShader.SetMat4("model", model);
-    spriteShader.SetVec4("color", color);
+void Renderer::DrawSpriteWorld(int sprite, const glm::vec2& position, const glm::vec2& size, float rotation,
+                              const glm::vec4& color, bool flipHorizontal) {
+    const AtlasSprite* atlasSprite = spriteAtlas.GetSprite(sprite);
+    if (!atlasSprite) return;
+    
+    // Only the non-transparent part is drawn: shrink the quad and move its
+    // center to where that part sits in the full quad (mirrored when flipped)
+    const glm::vec4& trim = atlasSprite->trimRect;
+    glm::vec2 trimmedSize = glm::vec2(trim.z - trim.x, trim.w - trim.y) * size;
+    if (trimmedSize.x <= 0.0f || trimmedSize.y <= 0.0f) return;
+    
+    glm::vec2 offset = (glm::vec2(trim.x + trim.z, trim.y + trim.w) * 0.5f - 0.5f) * size;
+    if (flipHorizontal) {
+        offset.x = -offset.x;
+    }
+    QueueSprite(position + Utils::RotateVector(offset, rotation), trimmedSize, rotation, color,
+                atlasSprite->page, atlasSprite->trimUVRect, flipHorizontal, false);
+}
+
+void Renderer::QueueSprite(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color,
+                           Texture* texture, const glm::vec4& uvRect, bool flipHorizontal, bool screenSpace) {
+    SyncCamera();
+    
+    SpriteInstance instance;
+    instance.position = position;
+    instance.size = size;
+    instance.uvRect[0] = PackUnorm16(flipHorizontal ? uvRect.z : uvRect.x);
+    instance.uvRect[1] = PackUnorm16(uvRect.y);
+    instance.uvRect[2] = PackUnorm16(flipHorizontal ? uvRect.x : uvRect.z);
+    instance.uvRect[3] = PackUnorm16(uvRect.w);
+    instance.color = PackColor(color);
+    instance.rotation = rotation;
+    instance.textured = texture ? 255 : 0;
+    instance.screenSpace = screenSpace ? 255 : 0;
+    instance.padding[0] = instance.padding[1] = 0;
+    
+    if (recorder) {
+        recorder->AddSprite(instance, texture, MakeSortKey(SORT_PROGRAM_SPRITES, texture));
+    } else {
+        SubmitSprite(instance, texture);
+    }
+}
+
+void Renderer::SubmitSprite(const SpriteInstance& instance, Texture* texture) {
+    DrawShapeBatch(); // Keep draw order: everything queued earlier goes first
+    DrawPrefabBatch();
+    DrawUiBatch();
+    DrawTextBatch();
     
+    // Solid sprites fit any batch; a textured one only breaks it when the texture changes
     if (texture) {
-        texture->Bind(0);
-        spriteShader.SetInt("textureSampler", 0);
-        spriteShader.SetInt("useTexture", 1);
-    } else {
-        whiteTexture.Bind(0);
-        spriteShader.SetInt("textureSampler", 0);
-        spriteShader.SetInt("useTexture", 0);
+        if (spriteBatchTexture && texture != spriteBatchTexture) {
+            DrawSpriteBatch();
+        }
+        spriteBatchTexture = texture;
     }
     
-    // Update vertex colors
-    float vertices[] = {
-        -0.5f, -0.5f,  0.0f, 0.0f,  color.r, color.g, color.b, color.a,
-         0.5f, -0.5f,  1.0f, 0.0f,  color.r, color.g, color.b, color.a,
-         0.5f,  0.5f,  1.0f, 1.0f,  color.r, color.g, color.b, color.a,
-        -0.5f,  0.5f,  0.0f, 1.0f,  color.r, color.g, color.b, color.a
-    };
+    if (!spriteWrite) {
+        spriteWrite = static_cast<SpriteInstance*>(
+            spriteStream.Map(MAX_SPRITES_PER_BATCH * sizeof(SpriteInstance), sizeof(SpriteInstance)));
+        if (!spriteWrite) return;
+    }
     
-    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+    // Stored whole; mapped memory is often write-combined
+    spriteWrite[spriteCount++] = instance;
     
-    glBindVertexArray(quadVAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    if (spriteCount >= MAX_SPRITES_PER_BATCH) {
+        DrawSpriteBatch();
+    }
+}
+
+void Renderer::FlushSprites() {
+    if (recorder) return;
+    DrawSpriteBatch();
+    DrawShapeBatch();
+    DrawPrefabBatch();
+    DrawUiBatch();
+}
+
+void Renderer::DrawSpriteBatch() {
+    if (!spriteWrite) return;
+    
+    size_t offset = spriteStream.Unmap(spriteCount * sizeof(SpriteInstance));
+    GLsizei count = spriteCount;
+    spriteWrite = nullptr;
+    spriteCount = 0;
+    
+    UpdateCameraBlock();
+    spriteBatchShader.Use();
+    (spriteBatchTexture ? spriteBatchTexture : &whiteTexture)->Bind(0);
+    spriteBatchTexture = nullptr;
+    
+    glBindVertexArray(spriteBatchVAO);
+    PointSpriteInstances(offset);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, count);
+    frameStats.drawCalls++;
+    frameStats.vertices += 6 * count;
     glBindVertexArray(0);
 }
 
-void Renderer::DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
-                              const glm::vec4& color, Texture* texture) {
-    DrawSpriteWorld(position, size, rotation, color, texture, false);
+void Renderer::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) {
+    DrawSprite(position, size, 0.0f, color, nullptr);
 }
 
-void Renderer::DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
-                              const glm::vec4& color, Texture* texture, bool flipHorizontal) {
-    spriteShader.Use();
-    
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(position, 0.0f));
-    model = glm::rotate(model, rotation, glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::scale(model, glm::vec3(size, 1.0f));
-    
-    glm::mat4 projection = GetProjectionMatrix();
-    glm::mat4 view = GetViewMatrix();
+void Renderer::DrawQuadWorld(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) {
+    DrawSpriteWorld(position, size, 0.0f, color, nullptr);
+}
+
+void Renderer::DrawCircle(const glm::vec2& position, float radius, const glm::vec4& color) {
+    QueueShape(position, radius, 0.0f, 0.0f, 0.0f, color, true);
+}
+
+void Renderer::DrawCircleWorld(const glm::vec2& position, float radius, const glm::vec4& color) {
+    QueueShape(position, radius, 0.0f, 0.0f, 0.0f, color, false);
+}
+
+void Renderer::DrawRingWorld(const glm::vec2& position, float radius, float thickness, const glm::vec4& color,
+                             float glow) {
+    QueueShape(position, radius, thickness, glow, 0.0f, color, false);
+}
+
+void Renderer::DrawGlowWorld(const glm::vec2& position, float radius, float glow, const glm::vec4& color,
+                             float core) {
+    QueueShape(position, radius, 0.0f, glow, core, color, false);
+}
+
+void Renderer::QueueShape(const glm::vec2& position, float radius, float thickness, float glow, float core,
+                          const glm::vec4& color, bool screenSpace) {
+    SyncCamera();
+    
+    ShapeInstance instance;
+    instance.position = position;
+    instance.radius = radius;
+    instance.thickness = thickness;
+    instance.glow = glow;
+    instance.core = core;
+    instance.color = PackColor(color);
+    instance.screenSpace = screenSpace ? 255 : 0;
+    instance.padding[0] = instance.padding[1] = instance.padding[2] = 0;
+    
+    if (recorder) {
+        recorder->AddShape(instance, MakeSortKey(SORT_PROGRAM_SHAPES, nullptr));
+    } else {
+        SubmitShape(instance);
+    }
+}
+
+void Renderer::SubmitShape(const ShapeInstance& instance) {
+    DrawSpriteBatch(); // Keep draw order: everything queued earlier goes first
+    DrawPrefabBatch();
+    DrawUiBatch();
+    DrawTextBatch();
+    
+    if (!shapeWrite) {
+        shapeWrite = static_cast<ShapeInstance*>(
+            shapeStream.Map(MAX_SHAPES_PER_BATCH * sizeof(ShapeInstance), sizeof(ShapeInstance)));
+        if (!shapeWrite) return;
+    }
     
-    spriteShader.SetMat4("projection", projection);
-    spriteShader.SetMat4("view", view);
-    spriteShader.SetMat4("model", model);
+    shapeWrite[shapeCount++] = instance;
     
-    if (texture) {
-        texture->Bind(0);
-        spriteShader.SetInt("textureSampler", 0);
-        spriteShader.SetInt("useTexture", 1);
-    } else {
-        whiteTexture.Bind(0);
-        spriteShader.SetInt("textureSampler", 0);
-        spriteShader.SetInt("useTexture", 0);
+    if (shapeCount >= MAX_SHAPES_PER_BATCH) {
+        DrawShapeBatch();
     }
+}
+
+void Renderer::DrawShapeBatch() {
+    if (!shapeWrite) return;
+    
+    size_t offset = shapeStream.Unmap(shapeCount * sizeof(ShapeInstance));
+    GLsizei count = shapeCount;
+    shapeWrite = nullptr;
+    shapeCount = 0;
+    
+    UpdateCameraBlock();
+    shapeShader.Use();
+    
+    glBindVertexArray(shapeVAO);
+    PointAttributes(SHAPE_LAYOUT, shapeStream.GetBuffer(), offset);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, count);
+    frameStats.drawCalls++;
+    frameStats.vertices += 6 * count;
+    glBindVertexArray(0);
+}
+
+int Renderer::CreatePrefab(const std::vector<PrefabPart>& parts) {
+    if (!prefabVBO || parts.empty()) return -1;
     
-    // Update vertex colors and flip texture coordinates if needed
-    float texLeft = flipHorizontal ? 1.0f : 0.0f;
-    float texRight = flipHorizontal ? 0.0f : 1.0f;
+    Prefab prefab;
+    prefab.firstVertex = static_cast<int>(prefabVertices.size());
+    prefab.vertexCount = static_cast<int>(parts.size()) * 6;
     
-    float vertices[] = {
-        -0.5f, -0.5f,  texLeft, 0.0f,  color.r, color.g, color.b, color.a,
-         0.5f, -0.5f,  texRight, 0.0f,  color.r, color.g, color.b, color.a,
-         0.5f,  0.5f,  texRight, 1.0f,  color.r, color.g, color.b, color.a,
-        -0.5f,  0.5f,  texLeft, 1.0f,  color.r, color.g, color.b, color.a
+    // Two triangles per part, in part order (later parts draw over earlier ones)
+    const glm::vec2 corners[6] = {
+        glm::vec2(-0.5f, -0.5f), glm::vec2(0.5f, -0.5f), glm::vec2(0.5f, 0.5f),
+        glm::vec2(0.5f, 0.5f), glm::vec2(-0.5f, 0.5f), glm::vec2(-0.5f, -0.5f)
     };
+    for (const PrefabPart& part : parts) {
+        for (const glm::vec2& corner : corners) {
+            PrefabVertex vertex;
+            vertex.position = part.offset + Utils::RotateVector(corner * part.size, part.rotation);
+            vertex.pivot = part.offset;
+            vertex.color = PackColor(part.color);
+            vertex.spin = part.spin;
+            vertex.tinted = part.tinted ? 255 : 0;
+            vertex.padding[0] = vertex.padding[1] = vertex.padding[2] = 0;
+            prefabVertices.push_back(vertex);
+        }
+    }
     
-    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+    // Prefabs are made at load time, so the whole mesh is simply uploaded again
+    glBindBuffer(GL_ARRAY_BUFFER, prefabVBO);
+    glBufferData(GL_ARRAY_BUFFER, prefabVertices.size() * sizeof(PrefabVertex), prefabVertices.data(),
+                 GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
     
-    glBindVertexArray(quadVAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    prefabs.push_back(prefab);
+    return static_cast<int>(prefabs.size()) - 1;
 }
 
-void Renderer::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) {
-    DrawSprite(position, size, 0.0f, color, nullptr);
-}
-
-void Renderer::DrawQuadWorld(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) {
-    DrawSpriteWorld(position, size, 0.0f, color, nullptr);
+void Renderer::DrawPrefabWorld(int prefab, const glm::vec2& position, const glm::vec2& scale, float rotation,
+                               const glm::vec4& tint, float spin) {
+    if (prefab < 0 || prefab >= static_cast<int>(prefabs.size())) return;
+    SyncCamera();
+    
+    PrefabInstance instance;
+    instance.position = position;
+    instance.scale = scale;
+    instance.rotation = rotation;
+    instance.spin = spin;
+    instance.tint = PackColor(tint);
+    
+    if (recorder) {
+        recorder->AddPrefab(instance, prefab,
+                            SortKey::Make(layer, blendMode, SORT_PROGRAM_PREFABS, prefab, layerDepth));
+    } else {
+        SubmitPrefab(instance, prefab);
+    }
 }
 
-void Renderer::DrawCircle(const glm::vec2& position, float radius, const glm::vec4& color, int segments) {
-    // Draw circle as a series of triangles
-    // For simplicity, we'll just draw a quad for now (would be circular with proper texture/shader)
-    DrawQuad(position, glm::vec2(radius * 2), color);
+void Renderer::SubmitPrefab(const PrefabInstance& instance, int prefab) {
+    DrawSpriteBatch(); // Keep draw order: everything queued earlier goes first
+    DrawShapeBatch();
+    DrawUiBatch();
+    DrawTextBatch();
+    
+    // One draw call covers one prefab's range of the mesh
+    if (prefab != prefabBatchPrefab) {
+        DrawPrefabBatch();
+        prefabBatchPrefab = prefab;
+    }
+    
+    if (!prefabWrite) {
+        prefabWrite = static_cast<PrefabInstance*>(
+            prefabStream.Map(MAX_PREFABS_PER_BATCH * sizeof(PrefabInstance), sizeof(PrefabInstance)));
+        if (!prefabWrite) return;
+    }
+    
+    prefabWrite[prefabCount++] = instance;
+    
+    if (prefabCount >= MAX_PREFABS_PER_BATCH) {
+        DrawPrefabBatch();
+    }
 }
 
-void Renderer::DrawCircleWorld(const glm::vec2& position, float radius, const glm::vec4& color, int segments) {
-    DrawQuadWorld(position, glm::vec2(radius * 2), color);
+void Renderer::DrawPrefabBatch() {
+    if (!prefabWrite) return;
+    
+    size_t offset = prefabStream.Unmap(prefabCount * sizeof(PrefabInstance));
+    GLsizei count = prefabCount;
+    prefabWrite = nullptr;
+    prefabCount = 0;
+    
+    const Prefab& prefab = prefabs[prefabBatchPrefab];
+    UpdateCameraBlock();
+    prefabShader.Use();
+    
+    glBindVertexArray(prefabVAO);
+    PointAttributes(PREFAB_INSTANCE_LAYOUT, prefabStream.GetBuffer(), offset);
+    glDrawArraysInstanced(GL_TRIANGLES, prefab.firstVertex, prefab.vertexCount, count);
+    frameStats.drawCalls++;
+    frameStats.vertices += prefab.vertexCount * count;
+    glBindVertexArray(0);
 }
 
 void Renderer::DrawLine(const glm::vec2& start, const glm::vec2& end, float thickness, const glm::vec4& color) {
@@ -658,8 +2264,7 @@ void Renderer::DrawLineWorld(const glm::vec2& start, const glm::vec2& end, float
 
 void Renderer::DrawRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) {
     // Position is top-left corner
-    glm::vec2 center = position + size * 0.5f;
-    DrawSprite(center, size, 0.0f, color, nullptr);
+    QueueUiRect(position, position + size, color);
 }
 
 void Renderer::DrawRectOutline(const glm::vec2& position, const glm::vec2& size, float thickness, const glm::vec4& color) {
@@ -689,8 +2294,93 @@ void Renderer::DrawProgressBar(const glm::vec2& position, const glm::vec2& size,
     }
 }
 
+void Renderer::DrawHealthBar(const glm::vec2& position, const glm::vec2& size, float fraction,
+                             const glm::vec4& fillColor, const glm::vec4& bgColor) {
+    fraction = Utils::Clamp(fraction, 0.0f, 1.0f);
+    
+    DrawRect(position, size, bgColor);
+    if (fraction > 0.0f) {
+        DrawRect(position, glm::vec2(size.x * fraction, size.y), fillColor);
+    }
+}
+
+void Renderer::PushClipRect(const glm::vec2& position, const glm::vec2& size) {
+    glm::vec4 clip(position.x, position.y, position.x + size.x, position.y + size.y);
+    if (!clipRects.empty()) {
+        // Nested clip rects only ever shrink the visible area
+        const glm::vec4& outer = clipRects.back();
+        clip = glm::vec4(std::max(clip.x, outer.x), std::max(clip.y, outer.y),
+                         std::min(clip.z, outer.z), std::min(clip.w, outer.w));
+    }
+    clipRects.push_back(clip);
+}
+
+void Renderer::PopClipRect() {
+    if (!clipRects.empty()) {
+        clipRects.pop_back();
+    }
+}
+
+void Renderer::QueueUiRect(glm::vec2 min, glm::vec2 max, const glm::vec4& color) {
+    // Axis-aligned rects clip exactly on the CPU, so clipping never breaks the batch
+    if (!clipRects.empty()) {
+        const glm::vec4& clip = clipRects.back();
+        min = glm::vec2(std::max(min.x, clip.x), std::max(min.y, clip.y));
+        max = glm::vec2(std::min(max.x, clip.z), std::min(max.y, clip.w));
+    }
+    if (min.x >= max.x || min.y >= max.y) return;
+    
+    UiRect rect;
+    rect.min = min;
+    rect.max = max;
+    rect.color = PackColor(color);
+    
+    if (recorder) {
+        recorder->AddUiRect(rect, MakeSortKey(SORT_PROGRAM_UI, nullptr));
+    } else {
+        SubmitUiRect(rect);
+    }
+}
+
+void Renderer::SubmitUiRect(const UiRect& rect) {
+    DrawSpriteBatch(); // Keep draw order: everything queued earlier goes first
+    DrawShapeBatch();
+    DrawPrefabBatch();
+    DrawTextBatch();
+    
+    if (!uiWrite) {
+        uiWrite = static_cast<UiRect*>(uiStream.Map(MAX_UI_RECTS_PER_BATCH * sizeof(UiRect), sizeof(UiRect)));
+        if (!uiWrite) return;
+    }
+    
+    uiWrite[uiCount++] = rect;
+    
+    if (uiCount >= MAX_UI_RECTS_PER_BATCH) {
+        DrawUiBatch();
+    }
+}
+
+void Renderer::DrawUiBatch() {
+    if (!uiWrite) return;
+    
+    size_t offset = uiStream.Unmap(uiCount * sizeof(UiRect));
+    GLsizei count = uiCount;
+    uiWrite = nullptr;
+    uiCount = 0;
+    
+    UpdateCameraBlock();
+    uiShader.Use();
+    
+    glBindVertexArray(uiVAO);
+    PointAttributes(UI_RECT_LAYOUT, uiStream.GetBuffer(), offset);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, count);
+    frameStats.drawCalls++;
+    frameStats.vertices += 6 * count;
+    glBindVertexArray(0);
+}
+
 void Renderer::DrawText(const std::string& text, const glm::vec2& position, float scale, const glm::vec4& color) {
-    if (!fontInitialized || characters.empty()) {
+    if (!fontInitialized) {
         // Fallback to simple rectangle rendering if font not initialized
         float charWidth = 10.0f * scale;
         float charHeight = 16.0f * scale;
@@ -713,33 +2403,77 @@ void Renderer::DrawText(const std::string& text, const glm::vec2& position, floa
         return;
     }
     
-    // Use text shader for proper font rendering
-    textShader.Use();
-    textShader.SetVec4("textColor", color);
-    textShader.SetMat4("projection", GetProjectionMatrix());
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(textVAO);
+    SyncCamera();
+    size_t maxVertices = text.size() * 6;
+    if (recorder) {
+        TextVertex* out = recorder->AddText(maxVertices, glm::vec2(0.0f), PackColor(color),
+                                            MakeSortKey(SORT_PROGRAM_TEXT, nullptr));
+        recorder->TrimText(maxVertices - AppendGlyphQuads(text, position, scale, color, out));
+        return;
+    }
+    
+    // A string longer than a whole batch is laid out on its own and drawn in chunks
+    const size_t batchVertices = MAX_GLYPHS_PER_BATCH * 6;
+    if (maxVertices > batchVertices) {
+        TextLayout layout;
+        layout.text = text;
+        layout.scale = scale;
+        layout.vertices.resize(maxVertices);
+        layout.vertices.resize(AppendGlyphQuads(text, glm::vec2(0.0f), scale, Colors::WHITE, layout.vertices.data()));
+        DrawText(layout, position, color);
+        return;
+    }
+    
+    DrawSpriteBatch(); // Keep draw order: everything but text queued earlier goes first
+    DrawShapeBatch();
+    DrawPrefabBatch();
+    DrawUiBatch();
     
-    // Iterate through all characters
+    if (textVertexCount + maxVertices > batchVertices) {
+        DrawTextBatch();
+    }
+    if (!MapTextBatch()) return;
+    textVertexCount += static_cast<int>(AppendGlyphQuads(text, position, scale, color, textWrite + textVertexCount));
+}
+
+bool Renderer::MapTextBatch() {
+    if (!textWrite) {
+        textWrite = static_cast<TextVertex*>(
+            textStream.Map(MAX_GLYPHS_PER_BATCH * 6 * sizeof(TextVertex), sizeof(TextVertex)));
+    }
+    return textWrite != nullptr;
+}
+
+size_t Renderer::AppendGlyphQuads(const std::string& text, const glm::vec2& position, float scale,
+                                  const glm::vec4& color, TextVertex* out) const {
+    // Writes at most six vertices per character; returns how many were written
+    TextVertex* first = out;
+    const uint32_t packedColor = PackColor(color);
+    auto vertex = [packedColor](float x, float y, uint16_t u, uint16_t v) {
+        TextVertex result;
+        result.position = glm::vec2(x, y);
+        result.texCoord[0] = u;
+        result.texCoord[1] = v;
+        result.color = packedColor;
+        return result;
+    };
     float x = position.x;
     float y = position.y;
     
-    for (auto it = text.begin(); it != text.end(); ++it) {
-        char c = *it;
-        
+    for (char c : text) {
         // Handle newlines
         if (c == '\n') {
             x = position.x;
-            y -= 48.0f * scale; // Move down one line (font size is 48)
+            y -= FONT_PIXEL_SIZE * scale; // Move down one line
             continue;
         }
         
-        // Get character data
-        if (characters.find(c) == characters.end()) {
-            continue; // Skip characters we don't have
+        // Skip characters we don't have
+        unsigned char code = static_cast<unsigned char>(c);
+        if (code >= FONT_GLYPH_COUNT || !characters[code].loaded) {
+            continue;
         }
-        
-        Character ch = characters[c];
+        const Character& ch = characters[code];
         
         // Calculate position
         // In a top-down coordinate system (0 at top), we need to add bearing for correct baseline
@@ -749,122 +2483,312 @@ void Renderer::DrawText(const std::string& text, const glm::vec2& position, floa
         float w = ch.size.x * scale;
         float h = ch.size.y * scale;
         
-        // Update VBO for each character
-        // Flip texture coordinates vertically (FreeType uses top-down, OpenGL uses bottom-up)
-        float vertices[6][4] = {
-            { xpos,     ypos + h,   0.0f, 1.0f },
-            { xpos,     ypos,       0.0f, 0.0f },
-            { xpos + w, ypos,       1.0f, 0.0f },
-            
-            { xpos,     ypos + h,   0.0f, 1.0f },
-            { xpos + w, ypos,       1.0f, 0.0f },
-            { xpos + w, ypos + h,   1.0f, 1.0f }
-        };
-        
-        // Render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.textureID);
-        
-        // Update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, textVBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        // Atlas rows run top-down like the FreeType bitmaps, so v0 is the glyph's top
+        const uint16_t u0 = PackUnorm16(ch.uvRect.x);
+        const uint16_t v0 = PackUnorm16(ch.uvRect.y);
+        const uint16_t u1 = PackUnorm16(ch.uvRect.z);
+        const uint16_t v1 = PackUnorm16(ch.uvRect.w);
+        *out++ = vertex(xpos,     ypos + h, u0, v1);
+        *out++ = vertex(xpos,     ypos,     u0, v0);
+        *out++ = vertex(xpos + w, ypos,     u1, v0);
         
-        // Render quad
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        *out++ = vertex(xpos,     ypos + h, u0, v1);
+        *out++ = vertex(xpos + w, ypos,     u1, v0);
+        *out++ = vertex(xpos + w, ypos + h, u1, v1);
         
         // Advance cursor for next glyph
         // Bitshift by 6 to get value in pixels (2^6 = 64 - FreeType uses 1/64th pixels)
         x += (ch.advance >> 6) * scale;
     }
+    return out - first;
+}
+
+std::shared_ptr<const TextLayout> Renderer::LayoutText(const std::string& text, float scale) {
+    // FNV-1a over the text and the scale's bit pattern
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : text) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    uint32_t scaleBits;
+    std::memcpy(&scaleBits, &scale, sizeof(scaleBits));
+    hash = (hash ^ scaleBits) * 1099511628211ull;
+    
+    TextCacheEntry& entry = textLayoutCache[hash];
+    entry.lastUsedFrame = frameIndex;
+    if (entry.layout && entry.layout->scale == scale && entry.layout->text == text) {
+        return entry.layout;
+    }
+    
+    // Miss (or a hash collision, which just replaces the old entry)
+    auto layout = std::make_shared<TextLayout>();
+    layout->text = text;
+    layout->scale = scale;
+    if (fontInitialized) {
+        layout->vertices.resize(text.size() * 6);
+        layout->vertices.resize(AppendGlyphQuads(text, glm::vec2(0.0f), scale, Colors::WHITE, layout->vertices.data()));
+    }
+    entry.layout = layout;
+    return layout;
+}
+
+void Renderer::DrawText(const TextLayout& layout, const glm::vec2& position, const glm::vec4& color) {
+    if (!fontInitialized) {
+        DrawText(layout.text, position, layout.scale, color);
+        return;
+    }
+    
+    SyncCamera();
+    const size_t total = layout.vertices.size();
+    if (recorder) {
+        TextVertex* out = recorder->AddText(total, position, PackColor(color), MakeSortKey(SORT_PROGRAM_TEXT, nullptr));
+        std::copy(layout.vertices.begin(), layout.vertices.end(), out);
+        return;
+    }
+    SubmitText(layout.vertices.data(), total, position, PackColor(color));
+}
+
+void Renderer::SubmitText(const TextVertex* vertices, size_t total, const glm::vec2& offset, uint32_t color) {
+    DrawSpriteBatch(); // Keep draw order: everything but text queued earlier goes first
+    DrawShapeBatch();
+    DrawPrefabBatch();
+    DrawUiBatch();
+    
+    // Whole quads only; runs longer than a batch are split across flushes
+    const size_t batchVertices = MAX_GLYPHS_PER_BATCH * 6;
+    if (textVertexCount + std::min(total, batchVertices) > batchVertices) {
+        DrawTextBatch();
+    }
+    for (size_t first = 0; first < total;) {
+        if (textVertexCount == static_cast<int>(batchVertices)) {
+            DrawTextBatch();
+        }
+        if (!MapTextBatch()) return;
+        
+        size_t count = std::min(total - first, batchVertices - textVertexCount);
+        TextVertex* out = textWrite + textVertexCount;
+        for (size_t i = 0; i < count; ++i) {
+            TextVertex v = vertices[first + i];
+            v.position += offset;
+            v.color = color;
+            out[i] = v;
+        }
+        textVertexCount += static_cast<int>(count);
+        first += count;
+    }
+}
+
+void Renderer::DrawTextCached(const std::string& text, const glm::vec2& position, float scale, const glm::vec4& color) {
+    DrawText(*LayoutText(text, scale), position, color);
+}
+
+void Renderer::EvictTextLayouts() {
+    for (auto it = textLayoutCache.begin(); it != textLayoutCache.end();) {
+        if (frameIndex - it->second.lastUsedFrame > TEXT_CACHE_MAX_AGE) {
+            it = textLayoutCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void Renderer::FlushText() {
+    if (!recorder) DrawTextBatch();
+}
+
+void Renderer::DrawTextBatch() {
+    if (!textWrite) return;
+    
+    size_t offset = textStream.Unmap(textVertexCount * sizeof(TextVertex));
+    GLsizei count = textVertexCount;
+    textWrite = nullptr;
+    textVertexCount = 0;
+    if (count == 0) return; // Only whitespace was queued
+    
+    UpdateCameraBlock();
+    textShader.Use();
+    fontAtlas.Bind(0);
     
+    glBindVertexArray(textVAO);
+    glDrawArrays(GL_TRIANGLES, static_cast<GLint>(offset / sizeof(TextVertex)), count);
+    frameStats.drawCalls++;
+    frameStats.vertices += count;
     glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 void Renderer::DrawStarfield(float time) {
-    for (const Star& star : stars) {
-        // Calculate twinkle effect
-        float twinkle = 0.5f + 0.5f * std::sin(time * star.twinkleSpeed + star.twinklePhase);
-        float alpha = star.brightness * (0.5f + 0.5f * twinkle);
-        
-        glm::vec4 starColor(1.0f, 1.0f, 1.0f, alpha);
-        
-        // Draw star in world space
-        DrawSpriteWorld(star.position, glm::vec2(star.size), 0.0f, starColor, nullptr);
+    SyncCamera();
+    if (recorder) {
+        recorder->DrawStarfield(time, MakeSortKey(SORT_PROGRAM_STARFIELD, nullptr));
+    } else {
+        SubmitStarfield(time);
     }
 }
 
+void Renderer::SubmitStarfield(float time) {
+    if (starCount == 0) return;
+    
+    DrawSpriteBatch(); // Keep draw order
+    DrawShapeBatch();
+    DrawPrefabBatch();
+    DrawUiBatch();
+    DrawTextBatch();
+    UpdateCameraBlock();
+    
+    starfieldShader.Use();
+    starfieldShader.SetFloat(U_TIME, time);
+    
+    glBindVertexArray(starVAO);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, starCount);
+    frameStats.drawCalls++;
+    frameStats.vertices += 6 * starCount;
+    glBindVertexArray(0);
+}
+
 void Renderer::DrawParticle(const glm::vec2& position, float size, const glm::vec4& color) {
-    // Add particle vertices (6 vertices for a quad - 2 triangles)
-    float halfSize = size * 0.5f;
-    
-    Vertex v1(glm::vec2(position.x - halfSize, position.y - halfSize), glm::vec2(0, 0), color);
-    Vertex v2(glm::vec2(position.x + halfSize, position.y - halfSize), glm::vec2(1, 0), color);
-    Vertex v3(glm::vec2(position.x + halfSize, position.y + halfSize), glm::vec2(1, 1), color);
-    Vertex v4(glm::vec2(position.x - halfSize, position.y - halfSize), glm::vec2(0, 0), color);
-    Vertex v5(glm::vec2(position.x + halfSize, position.y + halfSize), glm::vec2(1, 1), color);
-    Vertex v6(glm::vec2(position.x - halfSize, position.y + halfSize), glm::vec2(0, 1), color);
-    
-    particleVertices.push_back(v1);
-    particleVertices.push_back(v2);
-    particleVertices.push_back(v3);
-    particleVertices.push_back(v4);
-    particleVertices.push_back(v5);
-    particleVertices.push_back(v6);
+    SyncCamera();
+    
+    // One point per particle; the particle shaders expand and round it
+    ParticleVertex vertex;
+    vertex.position = position;
+    vertex.size = size;
+    vertex.color = PackColor(color);
+    
+    if (recorder) {
+        recorder->AddParticle(vertex, MakeSortKey(SORT_PROGRAM_PARTICLES, nullptr));
+    } else {
+        SubmitParticle(vertex);
+    }
+}
+
+void Renderer::SubmitParticle(const ParticleVertex& vertex) {
+    if (!particleWrite) {
+        particleWrite = static_cast<ParticleVertex*>(
+            particleStream.Map(MAX_PARTICLES_PER_BATCH * sizeof(ParticleVertex), sizeof(ParticleVertex)));
+        if (!particleWrite) return;
+    }
+    particleWrite[particleCount++] = vertex;
     
     // Flush if buffer is full
-    if (particleVertices.size() >= MAX_PARTICLES_PER_BATCH * 6) {
-        FlushParticles();
+    if (particleCount >= MAX_PARTICLES_PER_BATCH) {
+        DrawParticleBatch();
     }
 }
 
 void Renderer::FlushParticles() {
-    if (particleVertices.empty()) return;
+    if (!recorder) DrawParticleBatch();
+}
+
+void Renderer::DrawParticleBatch() {
+    if (!particleWrite) return;
     
-    spriteShader.Use();
-    spriteShader.SetMat4("projection", GetProjectionMatrix());
-    spriteShader.SetMat4("view", GetViewMatrix());
-    spriteShader.SetMat4("model", glm::mat4(1.0f));
-    spriteShader.SetInt("useTexture", 0);
+    size_t offset = particleStream.Unmap(particleCount * sizeof(ParticleVertex));
+    GLsizei count = particleCount;
+    particleWrite = nullptr;
+    particleCount = 0;
     
-    whiteTexture.Bind(0);
-    spriteShader.SetInt("textureSampler", 0);
+    DrawSpriteBatch(); // Keep draw order: everything queued earlier goes first
+    DrawShapeBatch();
+    DrawPrefabBatch();
+    DrawUiBatch();
+    DrawTextBatch();
     
-    glBindVertexArray(particleVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, particleVBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, particleVertices.size() * sizeof(Vertex), particleVertices.data());
+    // Attribute particle work to its own pass, then resume the caller's pass
+    GpuPass previousPass = gpuTimer.GetPass();
+    gpuTimer.SetPass(GpuPass::PARTICLES);
     
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(particleVertices.size()));
+    UpdateCameraBlock();
+    particleShader.Use();
+    
+    glBindVertexArray(particleVAO);
+    glDrawArrays(GL_POINTS, static_cast<GLint>(offset / sizeof(ParticleVertex)), count);
+    frameStats.drawCalls++;
+    frameStats.vertices += count;
     
     glBindVertexArray(0);
-    particleVertices.clear();
+    
+    gpuTimer.SetPass(previousPass);
 }
 
-void Renderer::SetScreenShake(float intensity, float duration) {
-    shakeIntensity = intensity;
-    shakeDuration = duration;
-    shakeTimer = 0.0f;
+bool Renderer::InitGpuParticles(int capacity) {
+    if (gpuParticles.IsInitialized()) return true;
+    return gpuParticles.Initialize(capacity);
 }
 
-void Renderer::UpdateScreenShake(float deltaTime) {
-    if (shakeDuration <= 0.0f) {
-        cameraShakeOffset = glm::vec2(0.0f);
-        return;
+void Renderer::SimulateGpuParticles(float deltaTime, const GpuParticle* spawns, int spawnCount) {
+    if (recorder) {
+        recorder->SimulateGpuParticles(deltaTime, spawns, spawnCount,
+                                       MakeSortKey(SORT_PROGRAM_GPU_PARTICLES, nullptr));
+    } else {
+        SubmitGpuParticleStep(deltaTime, spawns, spawnCount);
     }
-    
-    shakeTimer += deltaTime;
-    if (shakeTimer >= shakeDuration) {
-        shakeDuration = 0.0f;
-        cameraShakeOffset = glm::vec2(0.0f);
-        return;
+}
+
+void Renderer::SubmitGpuParticleStep(float deltaTime, const GpuParticle* spawns, int spawnCount) {
+    GpuPass previousPass = gpuTimer.GetPass();
+    gpuTimer.SetPass(GpuPass::PARTICLES);
+    gpuParticles.Simulate(deltaTime, spawns, spawnCount);
+    gpuTimer.SetPass(previousPass);
+}
+
+void Renderer::DrawGpuParticles() {
+    SyncCamera();
+    if (recorder) {
+        recorder->DrawGpuParticles(MakeSortKey(SORT_PROGRAM_GPU_PARTICLES, nullptr));
+    } else {
+        SubmitGpuParticleDraw();
     }
-    
-    // Calculate shake with decay
-    float decay = 1.0f - (shakeTimer / shakeDuration);
-    float currentIntensity = shakeIntensity * decay;
-    
-    cameraShakeOffset = glm::vec2(
-        Utils::RandomFloat(-currentIntensity, currentIntensity),
-        Utils::RandomFloat(-currentIntensity, currentIntensity)
-    );
 }
+
+void Renderer::ClearGpuParticles() {
+    if (recorder) {
+        recorder->ClearGpuParticles(MakeSortKey(SORT_PROGRAM_GPU_PARTICLES, nullptr));
+    } else {
+        gpuParticles.Clear();
+    }
+}
+
+void Renderer::SubmitGpuParticleDraw() {
+    if (gpuParticles.GetUsedSlots() == 0) return;
+    
+    DrawSpriteBatch(); // Keep draw order
+    DrawShapeBatch();
+    DrawPrefabBatch();
+    DrawUiBatch();
+    DrawTextBatch();
+    DrawParticleBatch();
+    
+    GpuPass previousPass = gpuTimer.GetPass();
+    gpuTimer.SetPass(GpuPass::PARTICLES);
+    UpdateCameraBlock();
+    gpuParticles.Draw();
+    gpuTimer.SetPass(previousPass);
+}
+
+void Renderer::SubmitGpuPass(GpuPass pass) {
+    if (pass != gpuTimer.GetPass()) {
+        DrawSpriteBatch();
+        DrawShapeBatch();
+        DrawPrefabBatch();
+        DrawUiBatch();
+        DrawTextBatch();
+    }
+    gpuTimer.SetPass(pass);
+}
+
+void Renderer::SubmitBlendMode(BlendMode mode) {
+    if (mode == submittedBlend) return;
+    
+    DrawSpriteBatch();
+    DrawShapeBatch();
+    DrawPrefabBatch();
+    DrawUiBatch();
+    DrawTextBatch();
+    DrawParticleBatch();
+    if (mode == BlendMode::ADDITIVE) {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    } else {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    submittedBlend = mode;
+}
+
@@ -7,7 +7,8 @@
 // ============================================================================
 
 #include "utils.h"
-#include <map>
+#include <cstdint>
+#include <mutex>
 
 // Include GLFW which brings in OpenGL headers
 // GL_GLEXT_PROTOTYPES enables function prototypes for OpenGL extensions
@@ -32,6 +33,113 @@ struct Vertex {
         : position(pos), texCoord(tex), color(col) {}
 };
 
+// ============================================================================
+// Particle Vertex (one point sprite per particle)
+// ============================================================================
+
+struct ParticleVertex {
+    glm::vec2 position;
+    float size;             // Diameter in pixels (gl_PointSize)
+    uint32_t color;         // RGBA8, red in the lowest byte
+};
+
+// ============================================================================
+// Per-Instance Sprite Data (instanced sprite batch)
+// ============================================================================
+
+struct SpriteInstance {
+    glm::vec2 position;     // Center
+    glm::vec2 size;
+    uint16_t uvRect[4];     // u0, v0, u1, v1 as unorm16 (u swapped to flip horizontally)
+    uint32_t color;         // RGBA8, red in the lowest byte
+    float rotation;
+    uint8_t textured;       // 0 = solid color, ignores the bound texture; 255 = textured
+    uint8_t screenSpace;    // 255 = UI coordinates, camera not applied
+    uint8_t padding[2];
+};
+
+// ============================================================================
+// Per-Instance Shape Data (circles, rings and glows shaded from their distance)
+// ============================================================================
+
+struct ShapeInstance {
+    glm::vec2 position;     // Center
+    float radius;           // Outer edge of the solid part
+    float thickness;        // Ring width inward from the edge; 0 = filled disc
+    float glow;             // Width of the soft halo outside the edge; 0 = none
+    float core;             // Radius of a white-hot center as a fraction of radius; 0 = none
+    uint32_t color;         // RGBA8, red in the lowest byte
+    uint8_t screenSpace;    // 255 = UI coordinates, camera not applied
+    uint8_t padding[3];
+};
+
+// ============================================================================
+// Prefabs (multi-part looks defined once as a static local-space mesh)
+// ============================================================================
+
+// One quad of a prefab; offsets and sizes are in units of the instance scale
+struct PrefabPart {
+    glm::vec2 offset;       // Center relative to the instance position
+    glm::vec2 size;
+    float rotation;         // Relative to the instance rotation
+    glm::vec4 color;
+    bool tinted;            // Color is multiplied by the instance tint (e.g. the entity's color)
+    float spin;             // Turns about its own center by spin * the instance's spin angle
+};
+
+struct PrefabVertex {
+    glm::vec2 position;     // Local space, already offset and rotated within the prefab
+    glm::vec2 pivot;        // Center of the part, which spinning parts turn around
+    uint32_t color;         // RGBA8, red in the lowest byte
+    float spin;
+    uint8_t tinted;         // 255 = multiplied by the instance tint
+    uint8_t padding[3];
+};
+
+struct PrefabInstance {
+    glm::vec2 position;
+    glm::vec2 scale;        // Local units to world units (usually the entity size)
+    float rotation;
+    float spin;             // Angle the spinning parts have turned
+    uint32_t tint;          // RGBA8, red in the lowest byte
+};
+
+// ============================================================================
+// UI Rect (batched screen-space rectangles, bars and outlines)
+// ============================================================================
+
+struct UiRect {
+    glm::vec2 min;          // Top-left corner, in pixels, already clipped
+    glm::vec2 max;          // Bottom-right corner
+    uint32_t color;         // RGBA8, red in the lowest byte
+};
+
+// ============================================================================
+// Text Vertex (batched glyph quads)
+// ============================================================================
+
+struct TextVertex {
+    glm::vec2 position;
+    uint16_t texCoord[2];   // Font atlas coordinates as unorm16
+    uint32_t color;         // RGBA8, red in the lowest byte
+};
+
+// ============================================================================
+// GPU Particle State (one record per slot of the GPU particle buffers)
+// ============================================================================
+
+struct GpuParticle {
+    glm::vec2 position;
+    glm::vec2 velocity;
+    float age;              // Seconds since spawn; the slot is free once age >= lifetime
+    float lifetime;
+    float drag;             // Velocity factor per 1/60 s, as in Particle
+    float startSize;
+    float endSize;
+    glm::vec4 startColor;
+    glm::vec4 endColor;
+};
+
 // ============================================================================
 // Shader Program
 // ============================================================================
@@ -46,17 +154,39 @@ public:
     bool LoadFromStrings(const std::string& vertexSource, const std::string& fragmentSource);
     bool LoadFromFiles(const std::string& vertexPath, const std::string& fragmentPath);
     
+    // Vertex-only program whose outputs are captured by transform feedback (interleaved)
+    bool LoadFeedbackFromFile(const std::string& vertexPath, const std::vector<const char*>& varyings);
+    
+    // Uniform names are interned to small IDs shared by all shaders; locations
+    // are looked up once at link time and cached per program
+    static int UniformID(const std::string& name);
+    GLint GetUniformLocation(int id) const;
+    
+    // Attach a named std140 block to a buffer binding point (false if the program has no such block)
+    bool BindUniformBlock(const char* blockName, GLuint binding) const;
+    
     void Use() const;
-    void SetInt(const std::string& name, int value) const;
-    void SetFloat(const std::string& name, float value) const;
-    void SetVec2(const std::string& name, const glm::vec2& value) const;
-    void SetVec3(const std::string& name, const glm::vec3& value) const;
-    void SetVec4(const std::string& name, const glm::vec4& value) const;
-    void SetMat4(const std::string& name, const glm::mat4& value) const;
+    void SetInt(int id, int value) const;
+    void SetFloat(int id, float value) const;
+    void SetVec2(int id, const glm::vec2& value) const;
+    void SetVec3(int id, const glm::vec3& value) const;
+    void SetVec4(int id, const glm::vec4& value) const;
+    void SetMat4(int id, const glm::mat4& value) const;
+    
+    // Convenience overloads (intern the name on every call; prefer cached IDs in hot paths)
+    void SetInt(const std::string& name, int value) const { SetInt(UniformID(name), value); }
+    void SetFloat(const std::string& name, float value) const { SetFloat(UniformID(name), value); }
+    void SetVec2(const std::string& name, const glm::vec2& value) const { SetVec2(UniformID(name), value); }
+    void SetVec3(const std::string& name, const glm::vec3& value) const { SetVec3(UniformID(name), value); }
+    void SetVec4(const std::string& name, const glm::vec4& value) const { SetVec4(UniformID(name), value); }
+    void SetMat4(const std::string& name, const glm::mat4& value) const { SetMat4(UniformID(name), value); }
     
 private:
     GLuint CompileShader(GLenum type, const std::string& source);
     bool CheckCompileErrors(GLuint shader, const std::string& type);
+    void ReflectUniforms();
+    
+    std::vector<GLint> uniformLocations;    // Indexed by uniform ID; -1 when not in this program
 };
 
 // ============================================================================
@@ -78,15 +208,80 @@ public:
 };
 
 // ============================================================================
-// Star (for background)
+// Texture Atlas
+// Every image in a directory packed onto as few pages as possible (shelf
+// packing, tallest first), so sprites drawn from it share a bound texture.
+// Each sprite is surrounded by a copy of its edge pixels, so filtering at the
+// border never picks up a neighbour. Sprites are looked up by file name
+// (without extension) once and then referenced by ID. The bounds of each
+// sprite's non-transparent texels are found at load time, and sprites are
+// drawn as a quad trimmed to them, so clear texels cost no fill rate.
+// ============================================================================
+
+struct AtlasSprite {
+    std::string name;
+    Texture* page;
+    glm::vec4 uvRect;       // u0, v0, u1, v1 on the page
+    glm::ivec2 size;        // Source image size in pixels
+    glm::vec4 trimRect;     // Non-transparent part as fractions of the image (x0, y0, x1, y1); empty if none
+    glm::vec4 trimUVRect;   // Same part on the page
+};
+
+class TextureAtlas {
+public:
+    static const int MAX_PAGE_SIZE = 2048;
+    static const int PADDING = 2;       // Extruded border around each sprite
+    
+    // Packs every .png in the directory (false if none could be loaded)
+    bool LoadDirectory(const std::string& directory);
+    void Clear();
+    
+    // -1 if there is no such sprite
+    int FindSprite(const std::string& name) const;
+    const AtlasSprite* GetSprite(int id) const;
+    int GetSpriteCount() const { return static_cast<int>(sprites.size()); }
+    int GetPageCount() const { return static_cast<int>(pages.size()); }
+
+private:
+    struct Image {
+        std::string name;
+        int width, height;
+        std::vector<unsigned char> pixels;  // RGBA8, bottom row first
+        glm::ivec4 opaqueBounds;            // Texels with alpha > 0: x0, y0, x1, y1 (exclusive)
+    };
+    
+    static glm::ivec4 FindOpaqueBounds(const Image& image);
+    
+    void Pack(const std::vector<Image>& images);
+    
+    std::vector<std::unique_ptr<Texture>> pages;
+    std::vector<AtlasSprite> sprites;
+    std::unordered_map<std::string, int> spriteIDs;
+};
+
+// ============================================================================
+// Star (for background; uploaded as-is to the static starfield buffer)
 // ============================================================================
 
 struct Star {
-    glm::vec2 position;
+    glm::vec2 position;     // Within the viewport; the shader scrolls and wraps it
     float size;
     float brightness;
     float twinkleSpeed;
     float twinklePhase;
+    float parallax;         // Fraction of camera movement the star follows
+};
+
+// A depth layer of the starfield; far layers scroll slower and are smaller and dimmer
+struct StarLayer {
+    float parallax;         // 1 = moves with the world, 0 = fixed on screen
+    float share;            // Fraction of all stars in this layer
+    float minSize, maxSize;
+    float minBrightness, maxBrightness;
+    
+    StarLayer(float p, float s, float size0, float size1, float bright0, float bright1)
+        : parallax(p), share(s), minSize(size0), maxSize(size1)
+        , minBrightness(bright0), maxBrightness(bright1) {}
 };
 
 // ============================================================================
@@ -94,78 +289,362 @@ struct Star {
 // ============================================================================
 
 struct Character {
-    GLuint textureID;   // ID handle of the glyph texture
+    glm::vec4 uvRect;   // Glyph rectangle in the font atlas (u0, v0, u1, v1)
     glm::ivec2 size;    // Size of glyph
     glm::ivec2 bearing; // Offset from baseline to left/top of glyph
     unsigned int advance;    // Offset to advance to next glyph
+    bool loaded;        // False for characters the font could not provide
 };
 
 // ============================================================================
-// Renderer Class
+// Text Layout (prebuilt glyph quads for strings that rarely change)
 // ============================================================================
 
-class Renderer {
+struct TextLayout {
+    std::string text;
+    float scale;
+    std::vector<TextVertex> vertices;   // Glyph quads relative to the text origin, in white
+};
+
+class IRenderer;
+
+// A piece of UI text bound to a value: formatting and layout only happen when
+// the value changes. Layouts are shared with the renderer's text cache.
+class TextLabel {
 public:
-    Renderer();
-    ~Renderer();
+    TextLabel() : boundValue(0), hasValue(false) {}
     
-    bool Initialize(int windowWidth, int windowHeight);
+    // True when the value differs from the last call (the caller then sets new text)
+    bool Changed(long long value);
+    void SetText(IRenderer& renderer, const std::string& text, float scale);
+    void Draw(IRenderer& renderer, const glm::vec2& position, const glm::vec4& color) const;
+    const std::string& GetText() const;
+
+private:
+    std::shared_ptr<const TextLayout> layout;
+    long long boundValue;
+    bool hasValue;
+};
+
+// ============================================================================
+// GPU Pass Timer
+// Double-buffered GL_TIME_ELAPSED query pools, read back without stalling
+// ============================================================================
+
+enum class GpuPass {
+    BACKGROUND,
+    WORLD,
+    PARTICLES,
+    UI,
+    COUNT
+};
+
+// ============================================================================
+// Render Layers
+// Every draw is queued with a sort key and the frame is sorted before it is
+// submitted. The layer decides what covers what; inside a layer, draws are
+// grouped by blend mode, program and texture, so the order between draws of
+// different kinds within one layer is not kept.
+// ============================================================================
+
+enum class RenderLayer : uint8_t {
+    BACKGROUND,         // Starfield
+    PICKUPS,            // XP orbs
+    ENEMIES,
+    ENEMY_OVERLAY,      // Health bars over the enemies
+    PLAYER,
+    PROJECTILES,        // Projectiles and weapon visuals
+    EFFECTS,            // Particles
+    HUD,
+    MENU,               // Menus and screens drawn over the HUD
+    DEBUG,              // Debug text and the profiler overlay
+    COUNT
+};
+
+enum class BlendMode : uint8_t {
+    ALPHA,
+    ADDITIVE
+};
+
+// GPU pass a layer's draws are timed in
+GpuPass GetLayerPass(RenderLayer layer);
+
+class GpuTimer {
+public:
+    static const int FRAME_BUFFERS = 2;     // Frames in flight before a pool is reused
+    static const int MAX_SEGMENTS = 32;     // Pass switches recorded per frame
+    
+    GpuTimer();
+    
+    void Initialize();
     void Shutdown();
     
-    // Frame management
-    void BeginFrame();
+    // Frame management; BeginFrame returns true when new timings were resolved
+    bool BeginFrame();
     void EndFrame();
     
+    // Switch the pass that subsequent GL commands are attributed to
+    void SetPass(GpuPass pass);
+    GpuPass GetPass() const { return activePass; }
+    
+    // Latest resolved timings
+    double GetPassMs(GpuPass pass) const { return passMs[static_cast<int>(pass)]; }
+    bool HasResults() const { return hasResults; }
+    static const char* GetPassName(GpuPass pass);
+
+private:
+    struct QueryPool {
+        GLuint queries[MAX_SEGMENTS];
+        GpuPass passes[MAX_SEGMENTS];
+        double submitTimes[MAX_SEGMENTS];  // CPU time each segment was issued, for trace captures
+        int used;
+    };
+    
+    void BeginSegment();
+    void EndSegment();
+    bool ResolvePool(QueryPool& pool);
+    
+    QueryPool pools[FRAME_BUFFERS];
+    int currentPool;
+    GpuPass activePass;
+    bool segmentOpen;
+    bool initialized;
+    bool hasResults;
+    double passMs[static_cast<int>(GpuPass::COUNT)];
+};
+
+// ============================================================================
+// Streaming Buffer
+// Ring buffer for geometry rebuilt every frame. A batch maps a range, writes
+// straight into it and unmaps before drawing. Ranges are mapped unsynchronized;
+// per-frame fences keep writes off data the GPU may still be reading, and when
+// the GPU is too far behind the buffer is orphaned instead of waited on.
+// ============================================================================
+
+class StreamBuffer {
+public:
+    static const int MAX_FRAMES_IN_FLIGHT = 4;   // Fenced frames before the ring is orphaned
+    
+    StreamBuffer();
+    
+    void Initialize(size_t capacityBytes);
+    void Shutdown();
+    
+    // Map room for up to maxBytes, starting on a multiple of stride (null if it can never fit)
+    void* Map(size_t maxBytes, size_t stride);
+    // Finish a mapped range after writing usedBytes; returns the offset the data starts at
+    size_t Unmap(size_t usedBytes);
+    bool IsMapped() const { return mapped != nullptr; }
+    
+    // Fence this frame's writes so their space can be reused once the GPU is done
+    void EndFrame();
+    
+    GLuint GetBuffer() const { return buffer; }
+
+private:
+    struct FrameFence {
+        GLsync fence;
+        size_t bytes;
+    };
+    
+    void RetireFrames();
+    void Orphan();
+    
+    GLuint buffer;
+    size_t capacity;
+    size_t head;            // Next free byte
+    size_t pendingBytes;    // Bytes the GPU may still read (fenced frames plus this one)
+    size_t frameBytes;      // Bytes written since the last fence
+    void* mapped;
+    bool mappedFallback;    // Mapping failed; the range lives in fallback and is uploaded on Unmap
+    std::vector<unsigned char> fallback;
+    FrameFence fences[MAX_FRAMES_IN_FLIGHT];
+    int firstFence;
+    int fenceCount;
+};
+
+// ============================================================================
+// GPU Particles
+// Particle state lives in two buffers; each step a transform feedback pass
+// reads one and writes the other, advancing every live particle. Spawns are
+// written into a ring of slots by the same pass, so the CPU only uploads the
+// new particles' descriptors.
+// ============================================================================
+
+class GpuParticles {
+public:
+    static const int MAX_SPAWNS_PER_STEP = 4096;
+    
+    GpuParticles();
+    
+    bool Initialize(int slotCount);
+    void Shutdown();
+    bool IsInitialized() const { return initialized; }
+    
+    // Advance all particles by deltaTime, then add the spawns (at age zero)
+    void Simulate(float deltaTime, const GpuParticle* spawns, int spawnCount);
+    void Draw();
+    void Clear();
+    
+    int GetCapacity() const { return capacity; }
+    int GetUsedSlots() const { return usedSlots; }     // Slots written so far; steps and draws cover these
+
+private:
+    void Advance(int first, int count, float deltaTime);
+    void Emit(int first, int count, size_t spawnOffset, int spawnIndex);
+    void BeginCapture(int first, int count);
+    
+    Shader updateShader;
+    Shader renderShader;
+    GLuint buffers[2];
+    GLuint vertexArrays[2];     // One per buffer, used for both stepping and drawing
+    GLuint spawnVAO;
+    StreamBuffer spawnStream;
+    int current;                // Buffer holding the latest state
+    int capacity;
+    int cursor;                 // Next slot to spawn into (oldest particles are overwritten first)
+    int usedSlots;
+    bool initialized;
+};
+
+// ============================================================================
+// Render Statistics (per frame)
+// ============================================================================
+
+struct RenderStats {
+    int drawCalls;
+    int programSwitches;    // glUseProgram calls
+    int textureBinds;
+    int uniformUploads;     // glUniform* calls
+    int bufferUploads;      // glBufferSubData calls and streamed ranges
+    size_t bytesUploaded;   // Vertex data streamed to the GPU
+    int bufferOrphans;      // Stream buffers orphaned because the GPU was behind
+    int vertices;           // Vertices (or indices) submitted by draw calls
+    int visibleObjects;     // Objects that passed IsVisible
+    int culledObjects;      // Objects skipped by IsVisible
+    
+    RenderStats()
+        : drawCalls(0), programSwitches(0), textureBinds(0), uniformUploads(0)
+        , bufferUploads(0), bytesUploaded(0), bufferOrphans(0), vertices(0)
+        , visibleObjects(0), culledObjects(0) {}
+};
+
+// Projection and view loaded into the shared camera uniform block
+struct RenderCamera {
+    glm::mat4 projection;
+    glm::mat4 view;
+};
+
+class RenderCommandBuffer;
+class RenderThread;
+
+// ============================================================================
+// Renderer Interface
+// What game code draws through. The GL back end is Renderer; render_backends.h
+// has a null back end (draws are dropped) and a recording one (draws are kept
+// in memory), so the render code can run and be timed without GL. Camera,
+// screen shake and culling live here, shared by every back end, so a run
+// simulates the same way whichever one it draws through.
+// ============================================================================
+
+class IRenderer {
+public:
+    IRenderer();
+    virtual ~IRenderer() = default;
+    
+    // Frame management; back ends call these first from their own
+    virtual void BeginFrame();
+    virtual void EndFrame();
+    
     // Camera
     void SetCameraPosition(const glm::vec2& position);
     glm::vec2 GetCameraPosition() const { return cameraPosition; }
     glm::vec2 ScreenToWorld(const glm::vec2& screenPos) const;
     glm::vec2 WorldToScreen(const glm::vec2& worldPos) const;
     
+    // Culling: does a world-space circle overlap the (shaken) view? Counts into the frame stats
+    bool IsVisible(const glm::vec2& center, float radius);
+    
+    // Screen effects
+    void SetScreenShake(float intensity, float duration);
+    void UpdateScreenShake(float deltaTime);
+    
+    // Layer and blend mode of the draws that follow; depth orders draws that
+    // share a layer, blend mode, program and texture (ties keep call order)
+    void SetLayer(RenderLayer layer, uint16_t depth = 0);
+    RenderLayer GetLayer() const { return layer; }
+    void SetBlendMode(BlendMode mode) { blendMode = mode; }
+    
     // Sprite rendering
-    void DrawSprite(const glm::vec2& position, const glm::vec2& size, float rotation,
-                   const glm::vec4& color, Texture* texture = nullptr);
-    void DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
-                        const glm::vec4& color, Texture* texture = nullptr);
-    void DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
-                        const glm::vec4& color, Texture* texture, bool flipHorizontal);
+    virtual void DrawSprite(const glm::vec2& position, const glm::vec2& size, float rotation,
+                            const glm::vec4& color, Texture* texture = nullptr) = 0;
+    virtual void DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
+                                 const glm::vec4& color, Texture* texture = nullptr) = 0;
+    virtual void DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
+                                 const glm::vec4& color, Texture* texture, bool flipHorizontal) = 0;
     
-    // Shape rendering (using sprite quad with white texture)
-    void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
-    void DrawQuadWorld(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
-    void DrawCircle(const glm::vec2& position, float radius, const glm::vec4& color, int segments = 16);
-    void DrawCircleWorld(const glm::vec2& position, float radius, const glm::vec4& color, int segments = 16);
-    void DrawLine(const glm::vec2& start, const glm::vec2& end, float thickness, const glm::vec4& color);
-    void DrawLineWorld(const glm::vec2& start, const glm::vec2& end, float thickness, const glm::vec4& color);
-    
-    // UI rendering (screen space)
-    void DrawRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
-    void DrawRectOutline(const glm::vec2& position, const glm::vec2& size, float thickness, const glm::vec4& color);
-    void DrawProgressBar(const glm::vec2& position, const glm::vec2& size, float progress,
-                        const glm::vec4& fillColor, const glm::vec4& bgColor);
-    void DrawText(const std::string& text, const glm::vec2& position, float scale, const glm::vec4& color);
+    // Atlas sprites (null when the back end has no such sprite)
+    virtual const AtlasSprite* GetSprite(int sprite) const = 0;
+    virtual void DrawSpriteWorld(int sprite, const glm::vec2& position, const glm::vec2& size, float rotation,
+                                 const glm::vec4& color, bool flipHorizontal = false) = 0;
+    
+    // Prefabs: build the mesh once (e.g. at load time), then draw each entity as one instance
+    virtual int CreatePrefab(const std::vector<PrefabPart>& parts) = 0;   // -1 on failure
+    virtual void DrawPrefabWorld(int prefab, const glm::vec2& position, const glm::vec2& scale, float rotation,
+                                 const glm::vec4& tint, float spin = 0.0f) = 0;
+    
+    // Shapes
+    virtual void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) = 0;
+    virtual void DrawQuadWorld(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) = 0;
+    virtual void DrawCircle(const glm::vec2& position, float radius, const glm::vec4& color) = 0;
+    virtual void DrawCircleWorld(const glm::vec2& position, float radius, const glm::vec4& color) = 0;
+    virtual void DrawRingWorld(const glm::vec2& position, float radius, float thickness, const glm::vec4& color,
+                               float glow = 0.0f) = 0;
+    // A disc with a soft halo glow units wide and, optionally, a white-hot core
+    virtual void DrawGlowWorld(const glm::vec2& position, float radius, float glow, const glm::vec4& color,
+                               float core = 0.0f) = 0;
+    virtual void DrawLine(const glm::vec2& start, const glm::vec2& end, float thickness, const glm::vec4& color) = 0;
+    virtual void DrawLineWorld(const glm::vec2& start, const glm::vec2& end, float thickness,
+                               const glm::vec4& color) = 0;
+    
+    // UI (screen space)
+    virtual void DrawRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) = 0;
+    virtual void DrawRectOutline(const glm::vec2& position, const glm::vec2& size, float thickness,
+                                 const glm::vec4& color) = 0;
+    virtual void DrawProgressBar(const glm::vec2& position, const glm::vec2& size, float progress,
+                                 const glm::vec4& fillColor, const glm::vec4& bgColor) = 0;
+    // Unpadded bar, filled from the left (e.g. over an enemy, at WorldToScreen of its position)
+    virtual void DrawHealthBar(const glm::vec2& position, const glm::vec2& size, float fraction,
+                               const glm::vec4& fillColor, const glm::vec4& bgColor) = 0;
+    // UI rects are clipped to the innermost clip rect (text is not); the stack is reset every frame
+    virtual void PushClipRect(const glm::vec2& position, const glm::vec2& size) = 0;
+    virtual void PopClipRect() = 0;
+    
+    // Text
+    virtual void DrawText(const std::string& text, const glm::vec2& position, float scale,
+                          const glm::vec4& color) = 0;
+    virtual std::shared_ptr<const TextLayout> LayoutText(const std::string& text, float scale) = 0;
+    virtual void DrawText(const TextLayout& layout, const glm::vec2& position, const glm::vec4& color) = 0;
+    virtual void DrawTextCached(const std::string& text, const glm::vec2& position, float scale,
+                                const glm::vec4& color) = 0;
     
     // Background
-    void DrawStarfield(float time);
-    void InitStarfield(int starCount);
+    virtual void DrawStarfield(float time) = 0;
     
-    // Particles (batch rendered)
-    void DrawParticle(const glm::vec2& position, float size, const glm::vec4& color);
-    void FlushParticles();
+    // Particles
+    virtual void DrawParticle(const glm::vec2& position, float size, const glm::vec4& color) = 0;
+    virtual void FlushParticles() = 0;
+    virtual void SimulateGpuParticles(float deltaTime, const GpuParticle* spawns, int spawnCount) = 0;
+    virtual void DrawGpuParticles() = 0;
+    virtual void ClearGpuParticles() = 0;
     
-    // Screen effects
-    void SetScreenShake(float intensity, float duration);
-    void UpdateScreenShake(float deltaTime);
+    // Statistics for the last completed frame (only culling counts without GL)
+    virtual RenderStats GetStats() const;
     
-    // Getters
     int GetWindowWidth() const { return windowWidth; }
     int GetWindowHeight() const { return windowHeight; }
-    Texture* GetWhiteTexture() { return &whiteTexture; }
-    
-private:
-    void InitQuadBuffers();
-    void InitParticleBuffers();
-    void InitTextRendering();
+
+protected:
     glm::mat4 GetProjectionMatrix() const;
     glm::mat4 GetViewMatrix() const;
     
@@ -178,40 +657,307 @@ private:
     float shakeIntensity;
     float shakeDuration;
     float shakeTimer;
+    bool cameraDirty;               // Camera moved since the back end last saw it
+    
+    // Sort state of the draws being recorded
+    RenderLayer layer;
+    uint16_t layerDepth;
+    BlendMode blendMode;
+    
+    // Culling counts
+    int visibleObjects, culledObjects;
+    int lastVisibleObjects, lastCulledObjects;
+};
+
+// ============================================================================
+// Renderer Class
+// Draw calls made during a frame are recorded into a command buffer with a
+// sort key each. At the end of the frame the commands are sorted and replayed
+// through the GL back end (the batchers below), either right away or, with a
+// render thread running, on that thread. Draws outside a frame go straight to
+// the back end.
+// ============================================================================
+
+class Renderer : public IRenderer {
+public:
+    Renderer();
+    ~Renderer();
+    
+    bool Initialize(int windowWidth, int windowHeight);
+    void Shutdown();
+    
+    // Move GL submission and presenting to a render thread (the window's context goes with it)
+    void StartRenderThread(GLFWwindow* window);
+    void StopRenderThread();
+    bool IsThreaded() const { return renderThread != nullptr; }
+    
+    // Frame management (with a render thread, EndFrame also presents)
+    void BeginFrame() override;
+    void EndFrame() override;
+    
+    // Sprite rendering
+    void DrawSprite(const glm::vec2& position, const glm::vec2& size, float rotation,
+                   const glm::vec4& color, Texture* texture = nullptr) override;
+    void DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
+                        const glm::vec4& color, Texture* texture = nullptr) override;
+    void DrawSpriteWorld(const glm::vec2& position, const glm::vec2& size, float rotation,
+                        const glm::vec4& color, Texture* texture, bool flipHorizontal) override;
+    
+    // Atlas sprites (all share the atlas pages, so they batch together)
+    bool LoadSpriteAtlas(const std::string& directory);
+    int FindSprite(const std::string& name) const { return spriteAtlas.FindSprite(name); }
+    const AtlasSprite* GetSprite(int sprite) const override { return spriteAtlas.GetSprite(sprite); }
+    void DrawSpriteWorld(int sprite, const glm::vec2& position, const glm::vec2& size, float rotation,
+                        const glm::vec4& color, bool flipHorizontal = false) override;
+    
+    // Prefabs: build the mesh once (e.g. at load time), then draw each entity as
+    // one instance; instances of one prefab batch into a single draw call
+    int CreatePrefab(const std::vector<PrefabPart>& parts) override;   // -1 on failure
+    void DrawPrefabWorld(int prefab, const glm::vec2& position, const glm::vec2& scale, float rotation,
+                         const glm::vec4& tint, float spin = 0.0f) override;
+    
+    // Shape rendering (using sprite quad with white texture)
+    void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) override;
+    void DrawQuadWorld(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) override;
+    
+    // Analytic shapes: one instanced quad each, antialiased from the distance to the edge
+    void DrawCircle(const glm::vec2& position, float radius, const glm::vec4& color) override;
+    void DrawCircleWorld(const glm::vec2& position, float radius, const glm::vec4& color) override;
+    void DrawRingWorld(const glm::vec2& position, float radius, float thickness, const glm::vec4& color,
+                       float glow = 0.0f) override;
+    void DrawGlowWorld(const glm::vec2& position, float radius, float glow, const glm::vec4& color,
+                       float core = 0.0f) override;
+    void DrawLine(const glm::vec2& start, const glm::vec2& end, float thickness, const glm::vec4& color) override;
+    void DrawLineWorld(const glm::vec2& start, const glm::vec2& end, float thickness,
+                       const glm::vec4& color) override;
+    
+    // UI rendering (screen space); rects, outlines and bars share one batch,
+    // drawn before the text of their layer
+    void DrawRect(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) override;
+    void DrawRectOutline(const glm::vec2& position, const glm::vec2& size, float thickness,
+                         const glm::vec4& color) override;
+    void DrawProgressBar(const glm::vec2& position, const glm::vec2& size, float progress,
+                        const glm::vec4& fillColor, const glm::vec4& bgColor) override;
+    void DrawHealthBar(const glm::vec2& position, const glm::vec2& size, float fraction,
+                       const glm::vec4& fillColor, const glm::vec4& bgColor) override;
+    void PushClipRect(const glm::vec2& position, const glm::vec2& size) override;
+    void PopClipRect() override;
+    void DrawText(const std::string& text, const glm::vec2& position, float scale, const glm::vec4& color) override;
+    
+    // Cached text: layouts are keyed by string and scale and dropped after going unused for a while
+    std::shared_ptr<const TextLayout> LayoutText(const std::string& text, float scale) override;
+    void DrawText(const TextLayout& layout, const glm::vec2& position, const glm::vec4& color) override;
+    void DrawTextCached(const std::string& text, const glm::vec2& position, float scale,
+                        const glm::vec4& color) override;
+    
+    // Background (one draw; stars live in a static buffer, the shader animates them)
+    void DrawStarfield(float time) override;
+    void InitStarfield(int count, const std::vector<StarLayer>& layers);
+    static int GetStarCountForResolution(int width, int height);
+    static std::vector<StarLayer> GetDefaultStarLayers();
+    
+    // Particles (batch rendered)
+    void DrawParticle(const glm::vec2& position, float size, const glm::vec4& color) override;
+    void FlushParticles() override;
+    
+    // GPU-simulated particles (optional; false if transform feedback setup fails)
+    bool InitGpuParticles(int capacity);
+    bool HasGpuParticles() const { return gpuParticles.IsInitialized(); }
+    void SimulateGpuParticles(float deltaTime, const GpuParticle* spawns, int spawnCount) override;
+    void DrawGpuParticles() override;
+    void ClearGpuParticles() override;
+    
+    // Draw all queued sprites, shapes and UI rects / text; called automatically before any other kind of draw
+    // (no-ops during a frame, where the sorted commands decide draw order)
+    void FlushSprites();
+    void FlushText();
+    
+    // GPU timing; each layer is timed in its pass (see GetLayerPass)
+    const GpuTimer& GetGpuTimer() const { return gpuTimer; }
+    
+    // Statistics for the last completed frame
+    RenderStats GetStats() const override;
+    
+    // Getters
+    Texture* GetWhiteTexture() { return &whiteTexture; }
+    
+private:
+    // Command replay drives the GL back end directly
+    friend class RenderCommandBuffer;
+    friend class RenderThread;
+    
+    void InitQuadBuffers();
+    void InitCameraBlock();
+    void UpdateCameraBlock();
+    void InitSpriteBatch();
+    void InitShapeBatch();
+    void InitPrefabBatch();
+    void InitUiBatch();
+    void InitParticleBuffers();
+    void PointSpriteInstances(size_t offset);
+    void QueueSprite(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color,
+                     Texture* texture, const glm::vec4& uvRect, bool flipHorizontal, bool screenSpace);
+    void QueueShape(const glm::vec2& position, float radius, float thickness, float glow, float core,
+                    const glm::vec4& color, bool screenSpace);
+    void QueueUiRect(glm::vec2 min, glm::vec2 max, const glm::vec4& color);
+    void SyncCamera();
+    uint64_t MakeSortKey(int program, const Texture* texture) const;
+    
+    // GL back end: runs on the main thread, or on the render thread when one is running
+    void BeginSubmission();
+    void EndSubmission();
+    void SubmitCamera(const RenderCamera& camera);
+    void SubmitSprite(const SpriteInstance& instance, Texture* texture);
+    void SubmitShape(const ShapeInstance& instance);
+    void SubmitPrefab(const PrefabInstance& instance, int prefab);
+    void SubmitUiRect(const UiRect& rect);
+    void SubmitText(const TextVertex* vertices, size_t count, const glm::vec2& offset, uint32_t color);
+    void SubmitParticle(const ParticleVertex& vertex);
+    void SubmitStarfield(float time);
+    void SubmitGpuPass(GpuPass pass);
+    void SubmitBlendMode(BlendMode mode);
+    void SubmitGpuParticleStep(float deltaTime, const GpuParticle* spawns, int spawnCount);
+    void SubmitGpuParticleDraw();
+    void DrawSpriteBatch();
+    void DrawShapeBatch();
+    void DrawPrefabBatch();
+    void DrawUiBatch();
+    void DrawTextBatch();
+    void DrawParticleBatch();
+    bool MapTextBatch();
+    size_t AppendGlyphQuads(const std::string& text, const glm::vec2& position, float scale,
+                            const glm::vec4& color, TextVertex* out) const;
+    void EvictTextLayouts();
+    void InitTextRendering();
+    
+    // Projection and view (with screen shake) shared by every program through a
+    // std140 uniform block; re-uploaded only when the camera changes
+    GLuint cameraUBO;
+    RenderCamera submittedCamera;   // Back end copy, uploaded before the next draw
+    bool cameraUploadPending;
     
     // Shaders
     Shader spriteShader;
+    Shader spriteBatchShader;
+    Shader shapeShader;
+    Shader prefabShader;
+    Shader uiShader;
     Shader particleShader;
     Shader textShader;
     
     // Buffers for sprite rendering
     GLuint quadVAO, quadVBO, quadEBO;
     
+    // Instanced sprite batch: sprites queue up until the texture changes or
+    // something else needs to draw, then go out in one instanced draw call
+    // Batches are written straight into mapped ranges of their stream buffers
+    GLuint spriteBatchVAO;
+    StreamBuffer spriteStream;
+    SpriteInstance* spriteWrite;    // Mapped range of the open batch (null when none)
+    int spriteCount;
+    Texture* spriteBatchTexture;    // Texture of the queued sprites (null while all are solid)
+    static const int MAX_SPRITES_PER_BATCH = 8192;
+    
+    // Instanced shape batch, drawn like the sprite batch
+    GLuint shapeVAO;
+    StreamBuffer shapeStream;
+    ShapeInstance* shapeWrite;
+    int shapeCount;
+    static const int MAX_SHAPES_PER_BATCH = 4096;
+    
+    // Prefab meshes share one static buffer; each prefab is a range of it.
+    // Instances batch like sprites, breaking when the prefab changes
+    struct Prefab {
+        int firstVertex;
+        int vertexCount;
+    };
+    std::vector<Prefab> prefabs;
+    std::vector<PrefabVertex> prefabVertices;   // CPU copy, re-uploaded when a prefab is added
+    GLuint prefabVAO, prefabVBO;
+    StreamBuffer prefabStream;
+    PrefabInstance* prefabWrite;
+    int prefabCount;
+    int prefabBatchPrefab;          // Prefab of the queued instances (-1 when none)
+    static const int MAX_PREFABS_PER_BATCH = 2048;
+    
+    // UI rect batch, drawn like the sprite batch; clipping happens as rects are queued
+    GLuint uiVAO;
+    StreamBuffer uiStream;
+    UiRect* uiWrite;
+    int uiCount;
+    static const int MAX_UI_RECTS_PER_BATCH = 4096;
+    std::vector<glm::vec4> clipRects;   // Min xy, max zw; innermost last
+    
     // Buffers for particle batching
-    GLuint particleVAO, particleVBO;
-    std::vector<Vertex> particleVertices;
+    GLuint particleVAO;
+    StreamBuffer particleStream;
+    ParticleVertex* particleWrite;
+    int particleCount;
     static const int MAX_PARTICLES_PER_BATCH = 10000;
     
-    // Buffers for text rendering
-    GLuint textVAO, textVBO;
+    // Text batch: glyph quads from the font atlas, drawn in one call per run
+    GLuint textVAO;
+    StreamBuffer textStream;
+    TextVertex* textWrite;
+    int textVertexCount;
+    static const int MAX_GLYPHS_PER_BATCH = 4096;
+    
+    // Each stream holds this many full batches, enough for a few frames in flight
+    static const int STREAM_BATCHES = 4;
+    
+    // Text layout cache, keyed by a hash of text and scale
+    struct TextCacheEntry {
+        std::shared_ptr<TextLayout> layout;
+        unsigned long long lastUsedFrame;
+    };
+    std::unordered_map<uint64_t, TextCacheEntry> textLayoutCache;
+    unsigned long long frameIndex;
+    static const int TEXT_CACHE_MAX_AGE = 300;     // Frames a layout may go unused before eviction
     
     // Default textures
     Texture whiteTexture;
     
+    // Sprites loaded from the asset directory
+    TextureAtlas spriteAtlas;
+    
     // Starfield
-    std::vector<Star> stars;
+    Shader starfieldShader;
+    GLuint starVAO, starVBO;
+    int starCount;
     
-    // Font rendering (FreeType)
+    // Font rendering (FreeType glyphs packed into one atlas, indexed by ASCII code)
+    static const int FONT_GLYPH_COUNT = 128;
     FT_Library ftLibrary;
     FT_Face ftFace;
-    std::map<char, Character> characters;
+    Character characters[FONT_GLYPH_COUNT];
+    Texture fontAtlas;
     bool fontInitialized;
+    
+    // GPU particle simulation
+    GpuParticles gpuParticles;
+    
+    // GPU pass timing
+    GpuTimer gpuTimer;
+    
+    // Render thread and the command buffer of the frame being recorded (null outside a frame);
+    // without a render thread, frames are recorded into frameCommands
+    std::unique_ptr<RenderThread> renderThread;
+    std::unique_ptr<RenderCommandBuffer> frameCommands;
+    RenderCommandBuffer* recorder;
+    
+    BlendMode submittedBlend;       // Back end: blend function currently set
+    
+    // Statistics of the last completed frame (the running counters live in
+    // renderer.cpp so Shader and Texture can update them too); written by the
+    // back end, so guarded for readers on the main thread
+    RenderStats lastFrameStats;
+    mutable std::mutex statsMutex;
 };
 
 // ============================================================================
 // Global Renderer Access (set by Game)
 // ============================================================================
 
-extern Renderer* g_Renderer;
+extern IRenderer* g_Renderer;
 
 #endif // RENDERER_H
@@ -66,6 +66,7 @@ namespace Constants {
     
     // Visual settings
     constexpr int MAX_PARTICLES = 5000;
+    constexpr int MAX_GPU_PARTICLES = 65536;    // Slots when particles are simulated on the GPU
     constexpr float PARTICLE_LIFETIME = 1.0f;
 }
 
@@ -153,6 +154,11 @@ namespace Utils {
         return rng;
     }
     
+    // Fixed seed for reproducible runs (headless replays, benchmarks)
+    inline void SeedRNG(unsigned int seed) {
+        GetRNG().seed(seed);
+    }
+    
     inline float RandomFloat(float min, float max) {
         std::uniform_real_distribution<float> dist(min, max);
         return dist(GetRNG());
@@ -330,21 +330,14 @@ std::string OrbitalWeapon::GetDescription() const {
     return "Orbital Lv." + std::to_string(level) + " (" + std::to_string(satellites.size()) + " sats)";
 }
 
-void OrbitalWeapon::Render(Renderer* renderer, const glm::vec2& playerPos) {
+void OrbitalWeapon::Render(IRenderer* renderer, const glm::vec2& playerPos) {
     (void)playerPos;
     
     for (const auto& sat : satellites) {
-        // Glow
-        glm::vec4 glowColor = glm::vec4(0.3f, 0.7f, 1.0f, 0.3f);
-        renderer->DrawSpriteWorld(sat.position, glm::vec2(satelliteSize * 1.5f), 0.0f, glowColor, nullptr);
-        
-        // Main body
+        // Body with its glow and a white core
         glm::vec4 bodyColor = glm::vec4(0.5f, 0.8f, 1.0f, 1.0f);
-        renderer->DrawSpriteWorld(sat.position, glm::vec2(satelliteSize), sat.angle * 2.0f, bodyColor, nullptr);
-        
-        // Core
-        glm::vec4 coreColor = Colors::WHITE;
-        renderer->DrawSpriteWorld(sat.position, glm::vec2(satelliteSize * 0.4f), -sat.angle * 3.0f, coreColor, nullptr);
+        float radius = satelliteSize * 0.5f;
+        renderer->DrawGlowWorld(sat.position, radius, radius * 0.5f, bodyColor, 0.4f);
     }
 }
 
@@ -437,21 +430,16 @@ std::string ShieldWeapon::GetDescription() const {
     return "Shield Lv." + std::to_string(level);
 }
 
-void ShieldWeapon::Render(Renderer* renderer, const glm::vec2& playerPos) {
+void ShieldWeapon::Render(IRenderer* renderer, const glm::vec2& playerPos) {
     if (!shieldActive) return;
     
     float healthPercent = shieldHealth / maxShieldHealth;
     float alpha = 0.2f + 0.3f * healthPercent;
     
-    // Outer shield
+    // Shield edge, its glow fading in toward the player
     glm::vec4 shieldColor = Colors::SHIELD_CYAN;
-    shieldColor.a = alpha;
-    renderer->DrawSpriteWorld(playerPos, glm::vec2(shieldRadius * 2.0f), 0.0f, shieldColor, nullptr);
-    
-    // Inner glow
-    glm::vec4 innerColor = Colors::SHIELD_CYAN;
-    innerColor.a = alpha * 0.5f;
-    renderer->DrawSpriteWorld(playerPos, glm::vec2(shieldRadius * 1.5f), 0.0f, innerColor, nullptr);
+    shieldColor.a = alpha + 0.3f;
+    renderer->DrawRingWorld(playerPos, shieldRadius, 3.0f, shieldColor, shieldRadius * 0.5f);
 }
 
 void ShieldWeapon::TakeShieldDamage(float damage) {
@@ -650,7 +638,7 @@ void WeaponManager::Update(float deltaTime, Game* game) {
     }
 }
 
-void WeaponManager::Render(Renderer* renderer, const glm::vec2& playerPos) {
+void WeaponManager::Render(IRenderer* renderer, const glm::vec2& playerPos) {
     // Render orbital weapons
     for (auto& weapon : weapons) {
         if (weapon->type == WeaponType::ORBITAL) {
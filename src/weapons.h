@@ -123,7 +123,7 @@ public:
     void LevelUp() override;
     std::string GetDescription() const override;
     
-    void Render(Renderer* renderer, const glm::vec2& playerPos);
+    void Render(IRenderer* renderer, const glm::vec2& playerPos);
     
 private:
     void UpdateSatellites(float deltaTime, Game* game);
@@ -155,7 +155,7 @@ public:
     void LevelUp() override;
     std::string GetDescription() const override;
     
-    void Render(Renderer* renderer, const glm::vec2& playerPos);
+    void Render(IRenderer* renderer, const glm::vec2& playerPos);
     void TakeShieldDamage(float damage);
     
 private:
@@ -214,7 +214,7 @@ public:
     WeaponManager();
     
     void Update(float deltaTime, Game* game);
-    void Render(Renderer* renderer, const glm::vec2& playerPos);
+    void Render(IRenderer* renderer, const glm::vec2& playerPos);
     
     // Weapon management
     bool AddWeapon(WeaponType type);
@@ -0,0 +1,70 @@
+// ============================================================================
+// Galaxies Away - Metrics to CSV Converter
+// Converts a binary per-frame metrics recording (--metrics) to CSV
+//
+// Usage: metrics2csv <metrics.bin> [output.csv]
+// ============================================================================
+
+#include "../src/metrics.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <metrics.bin> [output.csv]" << std::endl;
+        return 1;
+    }
+    
+    std::ifstream input(argv[1], std::ios::binary);
+    if (!input.is_open()) {
+        std::cerr << "Failed to open " << argv[1] << std::endl;
+        return 1;
+    }
+    
+    MetricsFileHeader header;
+    if (!input.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, MetricsFormat::MAGIC, sizeof(header.magic)) != 0) {
+        std::cerr << argv[1] << " is not a Galaxies Away metrics file" << std::endl;
+        return 1;
+    }
+    if (header.version == 0 || header.version > MetricsFormat::VERSION || header.recordSize == 0) {
+        std::cerr << "Unsupported metrics version " << header.version
+                  << " (record size " << header.recordSize << ")" << std::endl;
+        return 1;
+    }
+    
+    std::ofstream file;
+    if (argc >= 3) {
+        file.open(argv[2]);
+        if (!file.is_open()) {
+            std::cerr << "Failed to write " << argv[2] << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = argc >= 3 ? file : std::cout;
+    
+    out << "frame,game_time,frame_ms,update_ms,render_ms,draw_calls,bytes_uploaded,"
+        << "enemies,projectiles,orbs,particles,spawns,deaths,"
+        << "program_switches,texture_binds,uniform_uploads,buffer_uploads,vertices\n";
+    
+    // Older recordings have shorter records; fields they lack read as zero
+    std::vector<char> buffer(header.recordSize);
+    size_t copySize = std::min<size_t>(header.recordSize, sizeof(FrameRecord));
+    size_t frames = 0;
+    while (input.read(buffer.data(), header.recordSize)) {
+        FrameRecord r;
+        std::memset(&r, 0, sizeof(r));
+        std::memcpy(&r, buffer.data(), copySize);
+        out << r.frame << ',' << r.gameTime << ',' << r.frameMs << ',' << r.updateMs << ',' << r.renderMs << ','
+            << r.drawCalls << ',' << r.bytesUploaded << ',' << r.enemies << ',' << r.projectiles << ','
+            << r.orbs << ',' << r.particles << ',' << r.spawns << ',' << r.deaths << ','
+            << r.programSwitches << ',' << r.textureBinds << ',' << r.uniformUploads << ','
+            << r.bufferUploads << ',' << r.vertices << '\n';
+        frames++;
+    }
+    
+    std::cerr << "Converted " << frames << " frames" << std::endl;
+    return 0;
+}